@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_cnn.dir/bench/bench_cnn.cpp.o"
+  "CMakeFiles/bench_cnn.dir/bench/bench_cnn.cpp.o.d"
+  "bench_cnn"
+  "bench_cnn.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_cnn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_compiled_model.dir/bench/bench_compiled_model.cpp.o"
+  "CMakeFiles/bench_compiled_model.dir/bench/bench_compiled_model.cpp.o.d"
+  "bench_compiled_model"
+  "bench_compiled_model.pdb"
+  "generated/modelo_compiled.h"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_compiled_model.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_concurrent_inference.dir/bench/bench_concurrent_inference.cpp.o"
+  "CMakeFiles/bench_concurrent_inference.dir/bench/bench_concurrent_inference.cpp.o.d"
+  "bench_concurrent_inference"
+  "bench_concurrent_inference.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_concurrent_inference.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_large_batch.dir/bench/bench_large_batch.cpp.o"
+  "CMakeFiles/bench_large_batch.dir/bench/bench_large_batch.cpp.o.d"
+  "bench_large_batch"
+  "bench_large_batch.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_large_batch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_shared_weights.dir/bench/bench_shared_weights.cpp.o"
+  "CMakeFiles/bench_shared_weights.dir/bench/bench_shared_weights.cpp.o.d"
+  "bench_shared_weights"
+  "bench_shared_weights.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_shared_weights.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_stream.dir/bench/bench_stream.cpp.o"
+  "CMakeFiles/bench_stream.dir/bench/bench_stream.cpp.o.d"
+  "bench_stream"
+  "bench_stream.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_stream.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_training.dir/bench/bench_training.cpp.o"
+  "CMakeFiles/bench_training.dir/bench/bench_training.cpp.o.d"
+  "bench_training"
+  "bench_training.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_training.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/proyecto_final_compile.dir/src/compile_model.cpp.o"
+  "CMakeFiles/proyecto_final_compile.dir/src/compile_model.cpp.o.d"
+  "proyecto_final_compile"
+  "proyecto_final_compile.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/proyecto_final_compile.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
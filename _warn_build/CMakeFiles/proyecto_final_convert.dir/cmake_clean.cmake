@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/proyecto_final_convert.dir/src/convert_model.cpp.o"
+  "CMakeFiles/proyecto_final_convert.dir/src/convert_model.cpp.o.d"
+  "proyecto_final_convert"
+  "proyecto_final_convert.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/proyecto_final_convert.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
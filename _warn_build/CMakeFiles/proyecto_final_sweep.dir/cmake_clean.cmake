@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/proyecto_final_sweep.dir/src/sweep.cpp.o"
+  "CMakeFiles/proyecto_final_sweep.dir/src/sweep.cpp.o.d"
+  "proyecto_final_sweep"
+  "proyecto_final_sweep.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/proyecto_final_sweep.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/proyecto_final_test.dir/src/main2.cpp.o"
+  "CMakeFiles/proyecto_final_test.dir/src/main2.cpp.o.d"
+  "proyecto_final_test"
+  "proyecto_final_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/proyecto_final_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/proyecto_final_train.dir/src/main.cpp.o"
+  "CMakeFiles/proyecto_final_train.dir/src/main.cpp.o.d"
+  "proyecto_final_train"
+  "proyecto_final_train.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/proyecto_final_train.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_activation_checkpointing.dir/tests/test_activation_checkpointing.cpp.o"
+  "CMakeFiles/test_activation_checkpointing.dir/tests/test_activation_checkpointing.cpp.o.d"
+  "test_activation_checkpointing"
+  "test_activation_checkpointing.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_activation_checkpointing.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
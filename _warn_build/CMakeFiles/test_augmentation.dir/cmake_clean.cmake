@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_augmentation.dir/tests/test_augmentation.cpp.o"
+  "CMakeFiles/test_augmentation.dir/tests/test_augmentation.cpp.o.d"
+  "test_augmentation"
+  "test_augmentation.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_augmentation.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_checkpoint.dir/tests/test_checkpoint.cpp.o"
+  "CMakeFiles/test_checkpoint.dir/tests/test_checkpoint.cpp.o.d"
+  "test_checkpoint"
+  "test_checkpoint.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_checkpoint.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_compiled_model.dir/tests/test_compiled_model.cpp.o"
+  "CMakeFiles/test_compiled_model.dir/tests/test_compiled_model.cpp.o.d"
+  "generated/modelo_compiled.h"
+  "test_compiled_model"
+  "test_compiled_model.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_compiled_model.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_concurrent_inference.dir/tests/test_concurrent_inference.cpp.o"
+  "CMakeFiles/test_concurrent_inference.dir/tests/test_concurrent_inference.cpp.o.d"
+  "test_concurrent_inference"
+  "test_concurrent_inference.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_concurrent_inference.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
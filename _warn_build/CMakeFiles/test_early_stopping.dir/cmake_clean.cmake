@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_early_stopping.dir/tests/test_early_stopping.cpp.o"
+  "CMakeFiles/test_early_stopping.dir/tests/test_early_stopping.cpp.o.d"
+  "test_early_stopping"
+  "test_early_stopping.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_early_stopping.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
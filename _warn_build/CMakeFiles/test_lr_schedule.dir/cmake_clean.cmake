@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_lr_schedule.dir/tests/test_lr_schedule.cpp.o"
+  "CMakeFiles/test_lr_schedule.dir/tests/test_lr_schedule.cpp.o.d"
+  "test_lr_schedule"
+  "test_lr_schedule.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_lr_schedule.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
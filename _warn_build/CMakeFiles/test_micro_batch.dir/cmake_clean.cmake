@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_micro_batch.dir/tests/test_micro_batch.cpp.o"
+  "CMakeFiles/test_micro_batch.dir/tests/test_micro_batch.cpp.o.d"
+  "test_micro_batch"
+  "test_micro_batch.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_micro_batch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mnist_stream.dir/tests/test_mnist_stream.cpp.o"
+  "CMakeFiles/test_mnist_stream.dir/tests/test_mnist_stream.cpp.o.d"
+  "test_mnist_stream"
+  "test_mnist_stream.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mnist_stream.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_prefetch_loader.dir/tests/test_prefetch_loader.cpp.o"
+  "CMakeFiles/test_prefetch_loader.dir/tests/test_prefetch_loader.cpp.o.d"
+  "test_prefetch_loader"
+  "test_prefetch_loader.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_prefetch_loader.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_sparse_dense.dir/tests/test_sparse_dense.cpp.o"
+  "CMakeFiles/test_sparse_dense.dir/tests/test_sparse_dense.cpp.o.d"
+  "test_sparse_dense"
+  "test_sparse_dense.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_sparse_dense.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_tensor_telemetry.dir/tests/test_tensor_telemetry.cpp.o"
+  "CMakeFiles/test_tensor_telemetry.dir/tests/test_tensor_telemetry.cpp.o.d"
+  "test_tensor_telemetry"
+  "test_tensor_telemetry.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tensor_telemetry.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
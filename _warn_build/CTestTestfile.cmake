@@ -0,0 +1,52 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_warn_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(compiled_model "/root/repo/_warn_build/test_compiled_model" "/root/repo/modelo.nn")
+set_tests_properties(compiled_model PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;92;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(quantization "/root/repo/_warn_build/test_quantization" "/root/repo/modelo.nn")
+set_tests_properties(quantization PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;96;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(sparse_dense "/root/repo/_warn_build/test_sparse_dense")
+set_tests_properties(sparse_dense PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;100;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(pruning "/root/repo/_warn_build/test_pruning")
+set_tests_properties(pruning PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;104;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(inference_plan "/root/repo/_warn_build/test_inference_plan" "/root/repo/modelo.nn")
+set_tests_properties(inference_plan PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;108;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(metrics "/root/repo/_warn_build/test_metrics")
+set_tests_properties(metrics PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;113;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(concurrent_inference "/root/repo/_warn_build/test_concurrent_inference" "/root/repo/modelo.nn")
+set_tests_properties(concurrent_inference PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;118;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(profiler "/root/repo/_warn_build/test_profiler")
+set_tests_properties(profiler PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;123;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(tensor_telemetry "/root/repo/_warn_build/test_tensor_telemetry")
+set_tests_properties(tensor_telemetry PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;128;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(early_stopping "/root/repo/_warn_build/test_early_stopping")
+set_tests_properties(early_stopping PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;132;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(lr_schedule "/root/repo/_warn_build/test_lr_schedule")
+set_tests_properties(lr_schedule PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;136;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(conv2d "/root/repo/_warn_build/test_conv2d")
+set_tests_properties(conv2d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;140;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(batchnorm "/root/repo/_warn_build/test_batchnorm")
+set_tests_properties(batchnorm PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;144;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(micro_batch "/root/repo/_warn_build/test_micro_batch")
+set_tests_properties(micro_batch PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;149;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(activation_checkpointing "/root/repo/_warn_build/test_activation_checkpointing")
+set_tests_properties(activation_checkpointing PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;154;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(random "/root/repo/_warn_build/test_random")
+set_tests_properties(random PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;158;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(sweep "/root/repo/_warn_build/test_sweep")
+set_tests_properties(sweep PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;163;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(mnist_stream "/root/repo/_warn_build/test_mnist_stream")
+set_tests_properties(mnist_stream PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;167;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(augmentation "/root/repo/_warn_build/test_augmentation")
+set_tests_properties(augmentation PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;172;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(checkpoint "/root/repo/_warn_build/test_checkpoint")
+set_tests_properties(checkpoint PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;177;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(model_file "/root/repo/_warn_build/test_model_file")
+set_tests_properties(model_file PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;181;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(prefetch_loader "/root/repo/_warn_build/test_prefetch_loader")
+set_tests_properties(prefetch_loader PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;186;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(dequantize "/root/repo/_warn_build/test_dequantize")
+set_tests_properties(dequantize PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;190;add_test;/root/repo/CMakeLists.txt;0;")
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "synthetic_mnist.h"
+#include "utec/neural_network/data/augmentation.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+template<typename Body>
+double per_second(size_t repeats, Body body) {
+    const auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < repeats; ++i) body();
+    return repeats / chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// Batches aumentados por segundo (1..N workers) contra pasos de
+// entrenamiento por segundo del MLP de main.cpp con el mismo batch: si el
+// aumento produce más rápido de lo que la red consume, no la frena. Al final,
+// una época con el aumento dentro del PrefetchLoader y cuánto esperó la red.
+//
+//   bench_augmentation [batch] [batches] [workers max]
+int main(int argc, char* argv[]) {
+    const size_t batch = argc > 1 ? stoul(argv[1]) : 64;
+    const size_t batches = argc > 2 ? stoul(argv[2]) : 100;
+    const size_t max_workers = argc > 3 ? stoul(argv[3]) : max(1u, thread::hardware_concurrency());
+
+    Tensor<float, 2> X(0, 784), Y(0, 10);
+    bench::synthetic_mnist(batch * batches, 28, X, Y);
+    Tensor<float, 2> x(batch, 784), y(batch, 10);
+    copy(X.cbegin(), X.cbegin() + batch * 784, x.begin());
+    copy(Y.cbegin(), Y.cbegin() + batch * 10, y.begin());
+
+    auto nn = bench::build_mlp({128, 64}, 7);
+    SGD<float> sgd(0.01f);
+    nn.train_batch<BCELoss>(x, y, sgd);
+    const double steps = per_second(batches, [&] { nn.train_batch<BCELoss>(x, y, sgd); });
+    cout << "batch " << batch << ": entrenamiento " << fixed << setprecision(1) << steps << " pasos/s\n";
+    cout << setw(10) << "workers" << setw(14) << "batches/s" << setw(16) << "vs entrenar" << "\n";
+
+    vector<size_t> counts;
+    for (size_t workers = 1; workers < max_workers; workers *= 2) counts.push_back(workers);
+    counts.push_back(max_workers);
+    for (size_t workers : counts) {
+        AugmentationPipeline<float> pipeline({}, workers);
+        auto source = x;
+        const double rate = per_second(batches, [&] {
+            copy(x.cbegin(), x.cend(), source.begin());
+            pipeline(source.data.data(), batch);
+        });
+        cout << setw(10) << workers << setw(14) << rate << setw(15) << rate / steps << "x\n";
+    }
+
+    // Una época con el aumento en el hilo de prefetch.
+    AugmentationPipeline<float> pipeline({}, max_workers);
+    auto gather = [&](const size_t* idx, size_t n, float* xb, float* yb) {
+        for (size_t r = 0; r < n; ++r) {
+            copy_n(X.cbegin() + idx[r] * 784, 784, xb + r * 784);
+            copy_n(Y.cbegin() + idx[r] * 10, 10, yb + r * 10);
+        }
+    };
+    PrefetchLoader<float> loader(X.shape()[0], 784, 10, batch, pipeline.wrap(gather));
+    const auto start = chrono::steady_clock::now();
+    nn.train<BCELoss>(loader, 1, 0.01f);
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    const auto stats = loader.stats();
+    cout << "Epoca con aumento (" << max_workers << " workers): " << setprecision(2) << seconds
+         << " s, la red espero datos " << stats.consumer_wait << " s ("
+         << setprecision(1) << 100.0 * stats.consumer_wait / seconds << "%)\n";
+    return 0;
+}
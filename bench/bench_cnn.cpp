@@ -0,0 +1,110 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include "synthetic_mnist.h"
+#include "utec/neural_network/nn_metrics.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+vector<int> labels_of(const Tensor<float, 2>& Y) {
+    vector<int> labels(Y.shape()[0]);
+    for (size_t i = 0; i < labels.size(); ++i)
+        for (size_t j = 0; j < Y.shape()[1]; ++j)
+            if (Y(i, j) == 1.0f) labels[i] = static_cast<int>(j);
+    return labels;
+}
+
+// Desplaza cada imagen hasta `shift` pixeles en cada eje: el MLP tiene que
+// aprender cada posición por separado, la convolución no.
+void shift_images(Tensor<float, 2>& X, int shift, uint32_t seed) {
+    mt19937 gen(seed);
+    uniform_int_distribution<int> offset(-shift, shift);
+    vector<float> image(784);
+    for (size_t i = 0; i < X.shape()[0]; ++i) {
+        const int dy = offset(gen), dx = offset(gen);
+        fill(image.begin(), image.end(), 0.0f);
+        for (int r = 0; r < 28; ++r)
+            for (int c = 0; c < 28; ++c) {
+                const int sr = r - dy, sc = c - dx;
+                if (sr >= 0 && sr < 28 && sc >= 0 && sc < 28) image[r * 28 + c] = X(i, sr * 28 + sc);
+            }
+        copy(image.begin(), image.end(), X.data.begin() + i * 784);
+    }
+}
+
+// Conv 3x3 paso 2 (8 filtros) -> MaxPool 2x2 -> Conv 3x3 (16 filtros)
+// -> MaxPool 2x2 -> Dense 10, con ReLU tras cada convolución.
+NeuralNetwork<float> build_cnn(uint32_t seed) {
+    mt19937 gen(seed);
+    uniform_real_distribution<float> dist(-0.1f, 0.1f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+    auto zero = [](Tensor<float, 2>& t) { t.fill(0.0f); };
+
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Conv2D<float>>(1, 28, 28, 8, 3, init, zero, 2, 1));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<MaxPool2D<float>>(8, 14, 14));
+    nn.add_layer(make_unique<Conv2D<float>>(8, 7, 7, 16, 3, init, zero));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<MaxPool2D<float>>(16, 5, 5));
+    nn.add_layer(make_unique<Dense<float>>(16 * 2 * 2, 10, init, zero));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+    return nn;
+}
+
+// Multiplicaciones-sumas por muestra de las capas con pesos.
+size_t macs(const NeuralNetwork<float>& nn) {
+    size_t total = 0;
+    for (const auto& layer : nn.dlayers()) {
+        if (auto dense = dynamic_cast<const Dense<float>*>(layer.get())) total += dense->in_features() * dense->out_features();
+        if (auto conv = dynamic_cast<const Conv2D<float>*>(layer.get())) total += conv->macs();
+    }
+    return total;
+}
+
+size_t parameter_count(const NeuralNetwork<float>& nn) {
+    size_t total = 0;
+    for (const auto& layer : nn.dlayers())
+        for (auto* p : layer->parameters()) total += p->size();
+    return total;
+}
+
+} // namespace
+
+// CNN pequeña contra el MLP 784-128-64-10 sobre MNIST sintético con
+// desplazamientos: exactitud de prueba, multiplicaciones-sumas y parámetros.
+//
+//   bench_cnn [muestras] [epocas] [desplazamiento]
+int main(int argc, char* argv[]) {
+    const size_t samples = argc > 1 ? stoul(argv[1]) : 1000;
+    const size_t epochs = argc > 2 ? stoul(argv[2]) : 20;
+    const int shift = argc > 3 ? stoi(argv[3]) : 6;
+
+    Tensor<float, 2> X(0, 784), Y(0, 10), Xt(0, 784), Yt(0, 10);
+    bench::synthetic_mnist(samples, 21, X, Y);
+    bench::synthetic_mnist(2000, 22, Xt, Yt);
+    shift_images(X, shift, 23);
+    shift_images(Xt, shift, 24);
+    const auto test_labels = labels_of(Yt);
+
+    cout << samples << " muestras, " << epochs << " epocas, desplazamiento +-" << shift << "\n";
+    cout << setw(6) << "red" << setw(12) << "exactitud" << setw(12) << "MACs" << setw(12) << "params"
+         << setw(10) << "s" << "\n";
+    auto report = [&](const string& name, NeuralNetwork<float> nn, float lr) {
+        auto start = chrono::steady_clock::now();
+        nn.train<BCELoss, Adam>(X, Y, epochs, 64, lr);
+        const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        const double accuracy = evaluate(nn, Xt, test_labels, 10).accuracy();
+        cout << setw(6) << name << setw(12) << fixed << setprecision(4) << accuracy << setw(12) << macs(nn)
+             << setw(12) << parameter_count(nn) << setw(10) << setprecision(2) << seconds << "\n";
+    };
+    report("MLP", bench::build_mlp({128, 64}, 7), 0.002f);
+    report("CNN", build_cnn(7), 0.02f);
+    return 0;
+}
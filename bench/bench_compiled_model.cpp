@@ -0,0 +1,54 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "utec/neural_network/neural_network.h"
+#include "modelo_compiled.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Latencia por muestra: predict genérico, predict con plan de inferencia y
+// forward generado por el compilador AOT.
+int main(int argc, char* argv[]) {
+    const string path = argc > 1 ? argv[1] : "modelo.nn";
+    const size_t iterations = argc > 2 ? stoul(argv[2]) : 2000;
+
+    NeuralNetwork<float> nn, planned;
+    nn.load(path);
+    planned.load(path, true);
+
+    mt19937 gen(11);
+    uniform_real_distribution<float> dist(0.0f, 1.0f);
+    Tensor<float, 2> x(1, modelo_compiled::INPUT_SIZE);
+    for (auto& v : x) v = dist(gen);
+    float y[modelo_compiled::OUTPUT_SIZE];
+
+    auto measure = [&](auto&& fn) {
+        vector<double> samples(iterations);
+        for (size_t i = 0; i < iterations; ++i) {
+            auto start = chrono::high_resolution_clock::now();
+            fn();
+            auto end = chrono::high_resolution_clock::now();
+            samples[i] = chrono::duration<double, micro>(end - start).count();
+        }
+        sort(samples.begin(), samples.end());
+        return make_pair(samples[iterations / 2], samples[iterations * 99 / 100]);
+    };
+
+    float sink = 0.0f;
+    auto [predict_p50, predict_p99] = measure([&] { sink += nn.predict(x)(0, 0); });
+    auto [plan_p50, plan_p99] = measure([&] { sink += planned.predict(x)(0, 0); });
+    auto [compiled_p50, compiled_p99] = measure([&] {
+        modelo_compiled::forward(x.data.data(), y);
+        sink += y[0];
+    });
+
+    cout << "predict:   p50 " << predict_p50 << " us, p99 " << predict_p99 << " us" << endl;
+    cout << "plan:      p50 " << plan_p50 << " us, p99 " << plan_p99 << " us" << endl;
+    cout << "compilado: p50 " << compiled_p50 << " us, p99 " << compiled_p99 << " us" << endl;
+    cout << "Aceleracion (p50): " << predict_p50 / compiled_p50 << "x" << endl;
+    return sink == 12345.0f;
+}
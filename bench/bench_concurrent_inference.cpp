@@ -0,0 +1,43 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Muestras por segundo con 1..N hilos compartiendo una única red (infer_one
+// con contexto propio por hilo).
+int main(int argc, char* argv[]) {
+    const string path = argc > 1 ? argv[1] : "modelo.nn";
+    const size_t max_threads = argc > 2 ? stoul(argv[2]) : max(1u, thread::hardware_concurrency());
+    const size_t per_thread = argc > 3 ? stoul(argv[3]) : 20000;
+
+    NeuralNetwork<float> nn;
+    nn.load(path, true);
+    vector<float> x(784, 0.5f);
+
+    cout << "Nucleos: " << thread::hardware_concurrency() << endl;
+    double base = 0.0;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        auto start = chrono::steady_clock::now();
+        vector<thread> pool;
+        for (size_t t = 0; t < threads; ++t) {
+            pool.emplace_back([&] {
+                InferenceContext<float> context;
+                vector<float> y(10);
+                for (size_t i = 0; i < per_thread; ++i) nn.infer_one(x.data(), y.data(), context);
+            });
+        }
+        for (auto& t : pool) t.join();
+        const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        const double rate = threads * per_thread / seconds;
+        if (threads == 1) base = rate;
+        cout << setw(3) << threads << " hilos: " << fixed << setprecision(0) << rate << " muestras/s ("
+             << setprecision(2) << rate / base << "x)" << endl;
+    }
+    return 0;
+}
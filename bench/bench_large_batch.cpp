@@ -0,0 +1,74 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <string>
+#include "synthetic_mnist.h"
+#include "utec/neural_network/nn_metrics.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+struct Run {
+    double seconds;
+    double accuracy;
+};
+
+vector<int> labels_of(const Tensor<float, 2>& Y) {
+    vector<int> labels(Y.shape()[0]);
+    for (size_t i = 0; i < labels.size(); ++i)
+        for (size_t j = 0; j < Y.shape()[1]; ++j)
+            if (Y(i, j) == 1.0f) labels[i] = static_cast<int>(j);
+    return labels;
+}
+
+template<template <typename...> class OptimizerType>
+Run train(const Tensor<float, 2>& X, const Tensor<float, 2>& Y, const Tensor<float, 2>& Xt, const vector<int>& test_labels,
+          size_t epochs, size_t batch, float lr, shared_ptr<const LRSchedule<float>> schedule) {
+    auto nn = bench::build_mlp({128, 64}, 7);
+    nn.set_lr_schedule(std::move(schedule));
+    auto start = chrono::steady_clock::now();
+    nn.train<BCELoss, OptimizerType>(X, Y, epochs, batch, lr);
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return {seconds, evaluate(nn, Xt, test_labels, 10).accuracy()};
+}
+
+} // namespace
+
+// Mismo número de épocas con batch 64 (Adam, tasa fija) y con batch grande
+// (LAMB o LARS con warmup + coseno): exactitud y tiempo total.
+//
+//   bench_large_batch [muestras] [epocas] [batch grande]
+int main(int argc, char* argv[]) {
+    const size_t samples = argc > 1 ? stoul(argv[1]) : 16384;
+    const size_t epochs = argc > 2 ? stoul(argv[2]) : 5;
+    const size_t big = argc > 3 ? stoul(argv[3]) : 4096;
+
+    Tensor<float, 2> X(0, 784), Y(0, 10), Xt(0, 784), Yt(0, 10);
+    bench::synthetic_mnist(samples, 11, X, Y);
+    bench::synthetic_mnist(2000, 12, Xt, Yt);
+    const auto test_labels = labels_of(Yt);
+
+    const uint64_t steps = epochs * ((samples + big - 1) / big);
+    auto schedule = [&](uint64_t warmup) {
+        return make_shared<Warmup<float>>(warmup, make_shared<Cosine<float>>(steps - warmup, 0.01f));
+    };
+
+    cout << samples << " muestras, " << epochs << " epocas\n";
+    cout << setw(26) << "configuracion" << setw(12) << "tiempo s" << setw(12) << "exactitud" << "\n";
+    auto report = [](const string& name, const Run& r) {
+        cout << setw(26) << name << setw(12) << fixed << setprecision(2) << r.seconds
+             << setw(11) << setprecision(1) << r.accuracy * 100 << "%\n";
+    };
+    const auto small = train<Adam>(X, Y, Xt, test_labels, epochs, 64, 0.001f, nullptr);
+    report("Adam, batch 64", small);
+    const auto lamb = train<LAMB>(X, Y, Xt, test_labels, epochs, big, 0.1f, schedule(steps / 4));
+    report("LAMB, batch " + to_string(big), lamb);
+    const auto lars = train<LARS>(X, Y, Xt, test_labels, epochs, big, 8.0f, schedule(steps / 4));
+    report("LARS, batch " + to_string(big), lars);
+    cout << "Aceleracion LAMB: " << setprecision(2) << small.seconds / lamb.seconds << "x\n";
+    return 0;
+}
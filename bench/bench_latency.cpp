@@ -0,0 +1,96 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Cuenta las reservas de memoria del proceso para comprobar que predict_one
+// no reserva nada en régimen estable.
+static atomic<size_t> allocations{0};
+
+// Todas las formas (simple, arreglo, con tamaño) pasan por malloc/free para
+// que cada new tenga su delete correspondiente.
+static void* counted_alloc(size_t size) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void* operator new(size_t size) { return counted_alloc(size); }
+void* operator new[](size_t size) { return counted_alloc(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+// Latencia por muestra de predict_one: histograma, percentiles y reservas
+// por llamada, contra predict con un batch de 1.
+int main(int argc, char* argv[]) {
+    const string path = argc > 1 ? argv[1] : "modelo.nn";
+    const size_t iterations = argc > 2 ? stoul(argv[2]) : 20000;
+
+    NeuralNetwork<float> nn;
+    nn.load(path, true);
+
+    mt19937 gen(21);
+    uniform_real_distribution<float> dist(0.0f, 1.0f);
+    const size_t samples = 64;
+    auto probe = nn.predict(Tensor<float, 2>(1, 784));
+    const size_t outputs = probe.shape()[1];
+    Tensor<float, 2> X(samples, 784);
+    for (auto& v : X) v = dist(gen);
+    vector<float> y(outputs);
+
+    // Calentamiento: la primera llamada reserva los buffers del hilo.
+    for (size_t i = 0; i < 100; ++i) nn.predict_one(&X(i % samples, 0), y.data());
+
+    vector<double> latency(iterations);
+    const size_t before = allocations.load();
+    for (size_t i = 0; i < iterations; ++i) {
+        auto start = chrono::steady_clock::now();
+        nn.predict_one(&X(i % samples, 0), y.data());
+        latency[i] = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    }
+    const size_t during = allocations.load() - before;
+
+    Tensor<float, 2> x1(1, 784);
+    vector<double> batch_latency(iterations / 10);
+    for (size_t i = 0; i < batch_latency.size(); ++i) {
+        copy_n(&X(i % samples, 0), 784, x1.begin());
+        auto start = chrono::steady_clock::now();
+        auto out = nn.predict(x1);
+        batch_latency[i] = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    }
+
+    // Histograma en cubetas de 1 us hasta 20 us.
+    const size_t buckets = 20;
+    vector<size_t> histogram(buckets + 1, 0);
+    for (double v : latency) ++histogram[min(buckets, static_cast<size_t>(v))];
+    cout << "Histograma de latencia de predict_one (us):" << endl;
+    const size_t peak = *max_element(histogram.begin(), histogram.end());
+    for (size_t b = 0; b <= buckets; ++b) {
+        if (!histogram[b]) continue;
+        cout << (b < buckets ? " " : ">") << setw(2) << b << (b < buckets ? "-" + to_string(b + 1) : "   ")
+             << setw(8) << histogram[b] << " " << string(histogram[b] * 50 / peak, '#') << endl;
+    }
+
+    auto percentile = [](vector<double> v, double q) {
+        sort(v.begin(), v.end());
+        return v[min(v.size() - 1, static_cast<size_t>(q * v.size()))];
+    };
+    cout << fixed << setprecision(2);
+    cout << "predict_one: p50 " << percentile(latency, 0.5) << " us, p99 " << percentile(latency, 0.99)
+         << " us, p99.9 " << percentile(latency, 0.999) << " us" << endl;
+    cout << "predict (1 fila): p50 " << percentile(batch_latency, 0.5) << " us" << endl;
+    cout << "Reservas por llamada: " << double(during) / iterations << endl;
+    return during == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "utec/neural_network/nn_quantization.h"
+#include "utec/neural_network/data/mnist_loader.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Cuantización int8: exactitud y tiempo contra predict en fp32. Con un CSV de
+// MNIST se calibra con sus primeras muestras y se mide exactitud real; sin él
+// se usan entradas sintéticas y se reporta el acuerdo de argmax con fp32.
+namespace {
+
+size_t argmax_row(const Tensor<float, 2>& t, size_t r) {
+    size_t best = 0;
+    for (size_t j = 1; j < t.shape()[1]; ++j)
+        if (t(r, j) > t(r, best)) best = j;
+    return best;
+}
+
+template<typename Fn>
+double seconds_per_call(Fn&& fn, size_t iterations) {
+    auto start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < iterations; ++i) fn();
+    return chrono::duration<double>(chrono::high_resolution_clock::now() - start).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const string path = argc > 1 ? argv[1] : "modelo.nn";
+    const string csv = argc > 2 ? argv[2] : "";
+    const size_t iterations = argc > 3 ? stoul(argv[3]) : 20;
+    const size_t calibration_size = 512;
+
+    NeuralNetwork<float> nn;
+    nn.load(path);
+    auto first = nn.dlayers().empty() ? nullptr : dynamic_cast<const Dense<float>*>(nn.dlayers().front().get());
+    if (!first) {
+        cerr << "Error: el modelo debe empezar con una capa Dense" << endl;
+        return 1;
+    }
+    const size_t inputs = first->in_features();
+
+    Tensor<float, 2> X(0, inputs);
+    vector<int> labels;
+    MNISTLoader loader;
+    if (!csv.empty() && inputs == 784 && loader.loadTestData(csv) && loader.getTestSize() > 0) {
+        const size_t n = loader.getTestSize();
+        vector<size_t> indices(n);
+        iota(indices.begin(), indices.end(), 0);
+        X = Tensor<float, 2>(n, inputs);
+        Tensor<float, 2> Y(n, 10);
+        loader.gatherBatch(indices.data(), n, X.data.data(), Y.data.data(), false);
+        for (size_t r = 0; r < n; ++r) labels.push_back(static_cast<int>(argmax_row(Y, r)));
+    } else {
+        cout << "Sin datos MNIST: usando 2000 entradas sintéticas" << endl;
+        X = Tensor<float, 2>(2000, inputs);
+        mt19937 gen(3);
+        uniform_real_distribution<float> dist(0.0f, 1.0f);
+        for (auto& v : X) v = dist(gen);
+    }
+    const size_t n = X.shape()[0];
+
+    Tensor<float, 2> calibration(min(calibration_size, n), inputs);
+    copy_n(X.data.begin(), calibration.data.size(), calibration.data.begin());
+    auto quantized = QuantizedNetwork<float>::build(nn, calibration);
+
+    auto reference = nn.predict(X);
+    auto approx = quantized.predict(X);
+
+    size_t fp32_ok = 0, int8_ok = 0, agree = 0;
+    float max_diff = 0.0f;
+    for (size_t r = 0; r < n; ++r) {
+        const size_t a = argmax_row(reference, r), b = argmax_row(approx, r);
+        agree += a == b;
+        if (!labels.empty()) {
+            fp32_ok += static_cast<int>(a) == labels[r];
+            int8_ok += static_cast<int>(b) == labels[r];
+        }
+    }
+    for (size_t i = 0; i < reference.data.size(); ++i)
+        max_diff = max(max_diff, abs(reference.data[i] - approx.data[i]));
+
+    float sink = 0.0f;
+    const double fp32_time = seconds_per_call([&] { sink += nn.predict(X)(0, 0); }, iterations);
+    const double int8_time = seconds_per_call([&] { sink += quantized.predict(X)(0, 0); }, iterations);
+
+    cout << "Muestras: " << n << ", calibración: " << calibration.shape()[0] << endl;
+    if (!labels.empty()) {
+        cout << "Exactitud fp32: " << 100.0 * fp32_ok / n << "%, int8: " << 100.0 * int8_ok / n
+             << "% (delta " << 100.0 * (double(int8_ok) - double(fp32_ok)) / n << " pp)" << endl;
+    }
+    cout << "Acuerdo argmax fp32/int8: " << 100.0 * agree / n << "%, diferencia maxima: " << max_diff << endl;
+    cout << "Pesos int8: " << quantized.size_bytes() / 1024.0 << " KB" << endl;
+    cout << "fp32: " << fp32_time * 1e3 << " ms/batch, int8: " << int8_time * 1e3 << " ms/batch" << endl;
+    cout << "Aceleracion: " << fp32_time / int8_time << "x" << endl;
+    return sink == 12345.0f;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <functional>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Arranque en frío y memoria por réplica al cargar N instancias del mismo
+// modelo: texto (copia privada), binario copiado y binario compartido.
+namespace {
+
+// Memoria residente privada (residente - páginas respaldadas por archivo), en KB.
+double private_kb() {
+#ifdef __linux__
+    ifstream statm("/proc/self/statm");
+    size_t size = 0, resident = 0, shared = 0;
+    statm >> size >> resident >> shared;
+    return (resident - shared) * 4.0;
+#else
+    return 0.0;
+#endif
+}
+
+void run(const string& name, size_t replicas, const function<void(NeuralNetwork<float>&)>& load) {
+    vector<unique_ptr<NeuralNetwork<float>>> models;
+    Tensor<float, 2> x(1, 784);
+    x.fill(0.5f);
+    const double before = private_kb();
+    vector<double> times;
+    for (size_t i = 0; i < replicas; ++i) {
+        auto start = chrono::steady_clock::now();
+        auto nn = make_unique<NeuralNetwork<float>>();
+        load(*nn);
+        nn->predict(x); // toca todas las páginas de pesos
+        times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        models.push_back(std::move(nn));
+    }
+    const double growth = private_kb() - before;
+    double rest = 0.0;
+    for (size_t i = 1; i < times.size(); ++i) rest += times[i];
+    cout << setw(18) << left << name << right << fixed << setprecision(2)
+         << " primera " << setw(8) << times[0] << " ms, siguientes " << setw(8) << rest / max<size_t>(replicas - 1, 1)
+         << " ms, memoria privada " << setw(8) << growth / replicas << " KB/replica" << endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const string path = argc > 1 ? argv[1] : "modelo.nn";
+    const size_t replicas = argc > 2 ? stoul(argv[2]) : 8;
+
+    NeuralNetwork<float> source;
+    source.load(path);
+    const string binary = path + ".bench.nnb";
+    source.save_binary(binary);
+
+    cout << replicas << " replicas de " << path << endl;
+    run("texto", replicas, [&](NeuralNetwork<float>& nn) { nn.load(path); });
+    run("binario copiado", replicas, [&](NeuralNetwork<float>& nn) { nn.load_binary(binary, false); });
+    run("binario compartido", replicas, [&](NeuralNetwork<float>& nn) { nn.load_shared(binary); });
+    cout << "Mapeos activos al terminar: " << SharedMappings::active() << endl;
+    filesystem::remove(binary);
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <vector>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Primera capa podada al 90%: tamaño y tiempo de forward de Dense vs SparseDense.
+// Las entradas imitan a MNIST (~80% de pixeles en cero).
+int main(int argc, char* argv[]) {
+    const string path = argc > 1 ? argv[1] : "modelo.nn";
+    const double sparsity = argc > 2 ? stod(argv[2]) : 0.9;
+    const size_t iterations = argc > 3 ? stoul(argv[3]) : 20;
+
+    NeuralNetwork<float> nn;
+    nn.load(path);
+    auto dense = nn.dlayers().empty() ? nullptr : dynamic_cast<Dense<float>*>(nn.dlayers().front().get());
+    if (!dense) {
+        cerr << "Error: el modelo debe empezar con una capa Dense" << endl;
+        return 1;
+    }
+
+    const size_t n = 256;
+    Tensor<float, 2> X(n, dense->in_features());
+    mt19937 gen(9);
+    uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (auto& v : X) v = dist(gen) < 0.8f ? 0.0f : dist(gen);
+
+    auto before = nn.predict(X);
+    prune_by_magnitude(*dense, sparsity);
+    auto pruned = nn.predict(X);
+    SparseDense<float> sparse(*dense);
+
+    auto time_forward = [&](ILayer<float>& layer) {
+        float sink = 0.0f;
+        auto start = chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < iterations; ++i) sink += layer.forward(X)(0, 0);
+        const double ms = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+        return make_pair(ms / iterations, sink);
+    };
+    auto [dense_ms, s1] = time_forward(*dense);
+    auto [sparse_ms, s2] = time_forward(sparse);
+
+    size_t agree = 0;
+    for (size_t r = 0; r < n; ++r) {
+        size_t a = 0, b = 0;
+        for (size_t j = 1; j < before.shape()[1]; ++j) {
+            if (before(r, j) > before(r, a)) a = j;
+            if (pruned(r, j) > pruned(r, b)) b = j;
+        }
+        agree += a == b;
+    }
+
+    const size_t dense_bytes = (dense->in_features() + 1) * dense->out_features() * sizeof(float);
+    cout << "Dispersión: " << sparse.sparsity() * 100 << "% (" << sparse.nnz() << " pesos vivos)" << endl;
+    cout << "Acuerdo argmax antes/después de podar: " << 100.0 * agree / n << "%" << endl;
+    cout << "Tamaño: Dense " << dense_bytes / 1024.0 << " KB, SparseDense " << sparse.size_bytes() / 1024.0
+         << " KB (" << double(dense_bytes) / sparse.size_bytes() << "x)" << endl;
+    cout << "Forward: Dense " << dense_ms << " ms, SparseDense " << sparse_ms << " ms ("
+         << dense_ms / sparse_ms << "x)" << endl;
+    return s1 + s2 == 12345.0f;
+}
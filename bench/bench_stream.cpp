@@ -0,0 +1,159 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include "synthetic_mnist.h"
+#include "utec/neural_network/data/mnist_stream.h"
+#include "utec/neural_network/data/mnist_loader.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+double peak_rss_mb() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+#else
+    return 0.0;
+#endif
+}
+
+// Cuánto sube el pico de memoria residente al correr fn. El pico es
+// monótono, así que cada medición corre en su propio proceso hijo.
+double peak_growth_mb(const function<void()>& fn) {
+#if defined(__unix__) || defined(__APPLE__)
+    int fds[2];
+    if (pipe(fds) != 0) throw runtime_error("Cannot create pipe");
+    cout.flush();
+    const pid_t pid = fork();
+    if (pid < 0) throw runtime_error("Cannot fork");
+    if (pid == 0) {
+        close(fds[0]);
+        const double before = peak_rss_mb();
+        fn();
+        const double growth = peak_rss_mb() - before;
+        const bool sent = write(fds[1], &growth, sizeof(growth)) == static_cast<ssize_t>(sizeof(growth));
+        _exit(sent ? 0 : 1);
+    }
+    close(fds[1]);
+    double growth = 0;
+    const bool received = read(fds[0], &growth, sizeof(growth)) == static_cast<ssize_t>(sizeof(growth));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!received || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        throw runtime_error("Benchmark child process failed");
+    }
+    return growth;
+#else
+    fn();
+    return 0.0;
+#endif
+}
+
+} // namespace
+
+// MNISTStream: MB/s y muestras/s leyendo una época sola y entrenando desde
+// el stream, con su memoria fija contra la de MNISTLoader (todo el archivo).
+// Antes, el pico de memoria de preparar los datos como main con y sin
+// --stream: con --stream solo se cargan las filas de validación.
+//
+//   bench_stream [muestras] [epocas] [buffer de mezcla]
+int main(int argc, char* argv[]) {
+    const size_t samples = argc > 1 ? stoul(argv[1]) : 20000;
+    const size_t epochs = argc > 2 ? stoul(argv[2]) : 1;
+    const size_t shuffle_buffer = argc > 3 ? stoul(argv[3]) : 4096;
+    const size_t batch_size = 64;
+
+    const string path = "bench_stream.csv";
+    {
+        Tensor<float, 2> X(0, 784), Y(0, 10);
+        bench::synthetic_mnist(samples, 27, X, Y);
+        bench::write_mnist_csv(path, X, Y);
+    }
+    const double file_mb = filesystem::file_size(path) / (1024.0 * 1024.0);
+    cout << samples << " muestras, CSV de " << fixed << setprecision(1) << file_mb << " MB\n";
+
+    // Misma división que main (la validación es 1/12 del archivo, como
+    // 5000 de 60000): con --stream se cuentan las filas y se lee solo la
+    // cola; sin él, MNISTLoader carga todo y la validación sale de ahí.
+    const size_t validation = samples / 12;
+    const double stream_mb = peak_growth_mb([&] {
+        const size_t train = MNISTStream<float>::count_rows(path) - validation;
+        Tensor<float, 2> X_val(validation, 784), Y_val(validation, 10);
+        MNISTStream<float>::read_rows(path, train, X_val, Y_val);
+        MNISTStream<float> stream(path, batch_size, shuffle_buffer);
+        stream.limit_rows(train);
+        while (stream.next()) {}
+    });
+    const double loader_mb = peak_growth_mb([&] {
+        streambuf* saved = cout.rdbuf(nullptr);
+        MNISTLoader loader;
+        loader.loadTrainData(path);
+        cout.rdbuf(saved);
+        const size_t train = loader.getTrainSize() - validation;
+        Tensor<float, 2> X_val(validation, 784), Y_val(validation, 10);
+        vector<size_t> indices(validation);
+        iota(indices.begin(), indices.end(), train);
+        loader.gatherBatch(indices.data(), validation, X_val.data.data(), Y_val.data.data());
+    });
+    const double validation_mb = validation * (784 + 10) * sizeof(float) / (1024.0 * 1024.0);
+    cout << "Pico de memoria preparando los datos (validacion " << setprecision(2) << validation_mb << " MB): "
+         << "--stream " << stream_mb << " MB, MNISTLoader " << loader_mb << " MB\n";
+
+    cout << setw(28) << "modo" << setw(10) << "MB/s" << setw(14) << "muestras/s" << setw(14) << "memoria MB" << "\n";
+    auto report = [](const string& name, double mb_per_s, double samples_per_s, double memory_mb) {
+        cout << setw(28) << name << setw(10) << setprecision(1) << mb_per_s << setw(14) << setprecision(0)
+             << samples_per_s << setw(14) << setprecision(2) << memory_mb << "\n";
+    };
+
+    {
+        MNISTStream<float> stream(path, batch_size, shuffle_buffer);
+        while (stream.next()) {}
+        const auto& stats = stream.stats();
+        report("stream, solo lectura", stats.mb_per_s(), stats.samples_per_s(), stream.memory_ceiling() / (1024.0 * 1024.0));
+    }
+    {
+        streambuf* saved = cout.rdbuf(nullptr);
+        MNISTLoader loader;
+        const auto start = chrono::steady_clock::now();
+        loader.loadTrainData(path);
+        const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout.rdbuf(saved);
+        report("MNISTLoader, carga completa", file_mb / seconds, samples / seconds, loader.memoryBytes() / (1024.0 * 1024.0));
+    }
+    {
+        MNISTStream<float> stream(path, batch_size, shuffle_buffer);
+        auto nn = bench::build_mlp({128, 64}, 7);
+        const auto start = chrono::steady_clock::now();
+        nn.train<BCELoss, Adam>(stream, epochs, 0.001f);
+        const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        const auto& stats = stream.stats();
+        report("entrenando desde el stream", stats.bytes_read / (1024.0 * 1024.0) / seconds, stats.samples / seconds,
+               stream.memory_ceiling() / (1024.0 * 1024.0));
+        cout << "Lectura: " << setprecision(1) << 100.0 * stats.seconds / seconds << "% del tiempo de entrenamiento, "
+             << "perdida final " << setprecision(4) << nn.history().back().train_loss << "\n";
+    }
+
+    remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <thread>
+#include "synthetic_mnist.h"
+#include "utec/neural_network/nn_sweep.h"
+#include "utec/neural_network/data/mnist_loader.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+// Lo que hace cada proceso de proyecto_final_train: leer el CSV y armar sus
+// propios tensores.
+void load(const string& path, Tensor<float, 2>& X, Tensor<float, 2>& Y, Tensor<float, 2>& X_val,
+          Tensor<float, 2>& Y_val, size_t validation_size) {
+    streambuf* saved = cout.rdbuf(nullptr);
+    MNISTLoader loader;
+    loader.loadTrainData(path);
+    cout.rdbuf(saved);
+    const size_t total = loader.getTrainSize(), train_size = total - validation_size;
+    X = Tensor<float, 2>(train_size, 784);
+    Y = Tensor<float, 2>(train_size, 10);
+    X_val = Tensor<float, 2>(validation_size, 784);
+    Y_val = Tensor<float, 2>(validation_size, 10);
+    vector<size_t> indices(total);
+    iota(indices.begin(), indices.end(), size_t(0));
+    loader.gatherBatch(indices.data(), train_size, X.data.data(), Y.data.data());
+    loader.gatherBatch(indices.data() + train_size, validation_size, X_val.data.data(), Y_val.data.data());
+}
+
+} // namespace
+
+// Mismo barrido de tres formas: un "proceso" por configuración (cada una lee
+// el CSV y entrena todas las épocas, una tras otra), el runner con el
+// dataset cargado una vez y todos los núcleos, y el runner con successive
+// halving. Tiempo total y mejor exactitud de validación.
+//
+//   bench_sweep [muestras] [epocas] [hilos]
+int main(int argc, char* argv[]) {
+    const size_t samples = argc > 1 ? stoul(argv[1]) : 3000;
+    const size_t epochs = argc > 2 ? stoul(argv[2]) : 9;
+    const size_t workers = argc > 3 ? stoul(argv[3]) : 0;
+    const size_t validation_size = samples / 6;
+
+    const string path = "bench_sweep.csv";
+    {
+        Tensor<float, 2> X(0, 784), Y(0, 10);
+        bench::synthetic_mnist(samples, 50, X, Y);
+        bench::write_mnist_csv(path, X, Y);
+    }
+    const auto trials = sweep_grid<float>({0.001f, 0.003f, 0.01f}, {32, 128}, {{64}, {128, 64}});
+    const auto build = sweep_mlp<float>(784, 10);
+    cout << trials.size() << " configuraciones, " << samples << " muestras, " << epochs << " epocas, "
+         << (workers ? workers : max(1u, thread::hardware_concurrency())) << " hilos\n";
+    cout << setw(34) << "modo" << setw(12) << "tiempo s" << setw(12) << "exactitud" << "\n";
+    auto report = [](const string& name, double seconds, double accuracy) {
+        cout << setw(34) << name << setw(12) << fixed << setprecision(2) << seconds
+             << setw(11) << setprecision(1) << accuracy * 100 << "%\n";
+    };
+
+    double separate_seconds = 0.0, separate_best = 0.0;
+    {
+        const auto start = chrono::steady_clock::now();
+        for (const auto& trial : trials) {
+            Tensor<float, 2> X(0, 784), Y(0, 10), X_val(0, 784), Y_val(0, 10);
+            load(path, X, Y, X_val, Y_val, validation_size);
+            SweepRunner<float> runner(X, Y, X_val, Y_val, build);
+            SweepOptions options;
+            options.workers = 1;
+            options.rungs = 1;
+            options.min_epochs = epochs;
+            separate_best = max(separate_best, runner.run<BCELoss, Adam>({trial}, options).front().accuracy);
+        }
+        separate_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        report("un proceso por configuracion", separate_seconds, separate_best);
+    }
+
+    Tensor<float, 2> X(0, 784), Y(0, 10), X_val(0, 784), Y_val(0, 10);
+    const auto load_start = chrono::steady_clock::now();
+    load(path, X, Y, X_val, Y_val, validation_size);
+    const double load_seconds = chrono::duration<double>(chrono::steady_clock::now() - load_start).count();
+    remove(path.c_str());
+    SweepRunner<float> runner(X, Y, X_val, Y_val, build);
+
+    SweepOptions all;
+    all.workers = workers;
+    all.rungs = 1;
+    all.min_epochs = epochs;
+    auto start = chrono::steady_clock::now();
+    const auto full = runner.run<BCELoss, Adam>(trials, all);
+    const double full_seconds = load_seconds + chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    report("runner, dataset compartido", full_seconds, full.front().accuracy);
+
+    // eta = 3 y tres rondas: épocas/9, épocas/3 y épocas.
+    SweepOptions halving = all;
+    halving.rungs = 3;
+    halving.min_epochs = max<size_t>(1, epochs / 9);
+    start = chrono::steady_clock::now();
+    const auto pruned = runner.run<BCELoss, Adam>(trials, halving);
+    const double pruned_seconds = load_seconds + chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    report("runner + successive halving", pruned_seconds, pruned.front().accuracy);
+
+    cout << "Carga del CSV: " << setprecision(2) << load_seconds << " s (una vez contra " << trials.size() << ")\n";
+    cout << "Aceleracion: " << separate_seconds / full_seconds << "x compartiendo, "
+         << separate_seconds / pruned_seconds << "x con halving\n\n";
+    write_sweep_table(cout, pruned);
+    return 0;
+}
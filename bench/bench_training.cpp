@@ -0,0 +1,279 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <map>
+#include <algorithm>
+#include "synthetic_mnist.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+struct Config {
+    vector<size_t> hidden = {128, 64};
+    size_t samples = 6000;
+    size_t epochs = 2;
+    size_t batch = 64;
+    uint32_t seed = 2025;
+    string baseline;        // JSON con el que comparar
+    string output;          // JSON donde escribir los resultados
+    double threshold = 0.10;
+};
+
+struct Result {
+    double samples_per_sec = 0;
+    double epoch_seconds = 0;
+    double peak_rss_mb = 0;
+    double final_loss = 0;
+};
+
+// Pico de memoria residente del proceso (monótono: es el máximo hasta ahora,
+// por eso cada combinación corre en su propio proceso, ver run_isolated).
+double peak_rss_mb() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+#else
+    return 0.0;
+#endif
+}
+
+template<template <typename...> class LossType, template <typename...> class OptimizerType>
+Result run(const Config& config, const Tensor<float, 2>& X, const Tensor<float, 2>& Y, float learning_rate) {
+    auto nn = bench::build_mlp(config.hidden, config.seed);
+    auto start = chrono::steady_clock::now();
+    nn.train<LossType, OptimizerType>(X, Y, config.epochs, config.batch, learning_rate);
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    Result r;
+    r.samples_per_sec = double(config.samples * config.epochs) / seconds;
+    r.epoch_seconds = seconds / double(config.epochs);
+    r.peak_rss_mb = peak_rss_mb();
+    r.final_loss = LossType<float>(nn.predict(X), Y).loss();
+    return r;
+}
+
+// Corre la combinación en un proceso hijo para que su pico de memoria no
+// herede el de las anteriores. El hijo parte con los datos ya generados, que
+// son los mismos para todas.
+template<template <typename...> class LossType, template <typename...> class OptimizerType>
+Result run_isolated(const Config& config, const Tensor<float, 2>& X, const Tensor<float, 2>& Y, float learning_rate) {
+#if defined(__unix__) || defined(__APPLE__)
+    int fds[2];
+    if (pipe(fds) != 0) throw runtime_error("Cannot create pipe");
+    cout.flush();
+    const pid_t pid = fork();
+    if (pid < 0) throw runtime_error("Cannot fork");
+    if (pid == 0) {
+        close(fds[0]);
+        const Result r = run<LossType, OptimizerType>(config, X, Y, learning_rate);
+        const bool sent = write(fds[1], &r, sizeof(r)) == static_cast<ssize_t>(sizeof(r));
+        _exit(sent ? 0 : 1);
+    }
+    close(fds[1]);
+    Result r;
+    const bool received = read(fds[0], &r, sizeof(r)) == static_cast<ssize_t>(sizeof(r));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!received || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        throw runtime_error("Benchmark child process failed");
+    }
+    return r;
+#else
+    return run<LossType, OptimizerType>(config, X, Y, learning_rate);
+#endif
+}
+
+string join_sizes(const vector<size_t>& sizes) {
+    string text;
+    for (size_t i = 0; i < sizes.size(); ++i) text += (i ? "," : "") + to_string(sizes[i]);
+    return text;
+}
+
+struct Baseline {
+    map<string, string> config;       // valores del bloque "config", como texto
+    map<string, double> samples_per_sec;
+};
+
+// Lee {"config": {...}, "nombre": {"samples_per_sec": x, ...}, ...}: solo
+// lo que escribe write_json, sin un parser JSON general.
+Baseline read_baseline(const string& path) {
+    ifstream in(path);
+    if (!in) throw runtime_error("Cannot open baseline " + path);
+    stringstream buffer;
+    buffer << in.rdbuf();
+    const string text = buffer.str();
+    Baseline baseline;
+    const size_t config_start = text.find("\"config\": {");
+    if (config_start != string::npos) {
+        const size_t open = text.find('{', config_start), close = text.find('}', open);
+        stringstream fields(text.substr(open + 1, close - open - 1));
+        string field;
+        while (getline(fields, field, ',')) {
+            const size_t colon = field.find(':');
+            if (colon == string::npos) {
+                // "hidden": "128,64" se partió en la coma: sigue el valor anterior.
+                if (baseline.config.count("hidden")) baseline.config["hidden"] += "," + field;
+                continue;
+            }
+            auto trim = [](string v) {
+                const size_t a = v.find_first_not_of(" \""), b = v.find_last_not_of(" \"");
+                return a == string::npos ? string() : v.substr(a, b - a + 1);
+            };
+            baseline.config[trim(field.substr(0, colon))] = trim(field.substr(colon + 1));
+        }
+        if (baseline.config.count("hidden")) {
+            string& hidden = baseline.config["hidden"];
+            hidden.erase(remove(hidden.begin(), hidden.end(), '"'), hidden.end());
+            hidden.erase(remove(hidden.begin(), hidden.end(), ' '), hidden.end());
+        }
+    }
+    size_t pos = 0;
+    while ((pos = text.find("\"samples_per_sec\"", pos)) != string::npos) {
+        const size_t name_end = text.rfind("\": {", pos);
+        const size_t name_start = text.rfind('"', name_end - 1);
+        const string name = text.substr(name_start + 1, name_end - name_start - 1);
+        pos = text.find(':', pos) + 1;
+        baseline.samples_per_sec[name] = stod(text.substr(pos));
+    }
+    return baseline;
+}
+
+// Campos de la configuración que no coinciden con los de la referencia (los
+// que la referencia no trae no se comparan).
+vector<string> config_mismatches(const Config& config, const map<string, string>& reference) {
+    const map<string, string> current = {
+        {"hidden", join_sizes(config.hidden)}, {"samples", to_string(config.samples)},
+        {"epochs", to_string(config.epochs)}, {"batch", to_string(config.batch)}, {"seed", to_string(config.seed)},
+    };
+    vector<string> mismatches;
+    for (const auto& [key, value] : current) {
+        auto it = reference.find(key);
+        if (it != reference.end() && it->second != value)
+            mismatches.push_back(key + " " + value + " (referencia " + it->second + ")");
+    }
+    return mismatches;
+}
+
+void write_json(const string& path, const Config& config, const vector<pair<string, Result>>& results) {
+    ofstream out(path);
+    out << fixed << setprecision(4) << "{\n";
+    out << "  \"config\": {\"hidden\": \"" << join_sizes(config.hidden) << "\", \"samples\": " << config.samples
+        << ", \"epochs\": " << config.epochs
+        << ", \"batch\": " << config.batch << ", \"seed\": " << config.seed << "},\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& [name, r] = results[i];
+        out << "  \"" << name << "\": {\"samples_per_sec\": " << r.samples_per_sec
+            << ", \"epoch_seconds\": " << r.epoch_seconds << ", \"peak_rss_mb\": " << r.peak_rss_mb
+            << ", \"final_loss\": " << r.final_loss << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "}\n";
+}
+
+vector<size_t> parse_sizes(const string& text) {
+    vector<size_t> sizes;
+    stringstream in(text);
+    string item;
+    while (getline(in, item, ',')) if (!item.empty()) sizes.push_back(stoul(item));
+    return sizes;
+}
+
+} // namespace
+
+// Rendimiento de train de punta a punta con datos sintéticos deterministas,
+// para cada combinación de pérdida y optimizador, cada una en su proceso.
+// Con --baseline devuelve 1 si alguna combinación cae más de --threshold
+// respecto de la referencia, y 2 si la referencia se midió con otra
+// configuración.
+//
+//   bench_training [--hidden 128,64] [--samples N] [--epochs E] [--batch B]
+//                  [--seed S] [--baseline ref.json] [--threshold 0.10]
+//                  [--output resultados.json]
+int main(int argc, char* argv[]) {
+    Config config;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const string flag = argv[i], value = argv[i + 1];
+        if (flag == "--hidden") config.hidden = parse_sizes(value);
+        else if (flag == "--samples") config.samples = stoul(value);
+        else if (flag == "--epochs") config.epochs = stoul(value);
+        else if (flag == "--batch") config.batch = stoul(value);
+        else if (flag == "--seed") config.seed = static_cast<uint32_t>(stoul(value));
+        else if (flag == "--baseline") config.baseline = value;
+        else if (flag == "--threshold") config.threshold = stod(value);
+        else if (flag == "--output") config.output = value;
+        else {
+            cerr << "Opcion desconocida: " << flag << endl;
+            return 2;
+        }
+    }
+
+    Baseline baseline;
+    if (!config.baseline.empty()) {
+        baseline = read_baseline(config.baseline);
+        const auto mismatches = config_mismatches(config, baseline.config);
+        if (!mismatches.empty()) {
+            cerr << "La referencia " << config.baseline << " usa otra configuracion:";
+            for (const auto& m : mismatches) cerr << "\n  " << m;
+            cerr << endl;
+            return 2;
+        }
+    }
+
+    Tensor<float, 2> X(0, 784), Y(0, 10);
+    bench::synthetic_mnist(config.samples, config.seed, X, Y);
+
+    cout << "MLP 784";
+    for (size_t h : config.hidden) cout << "-" << h;
+    cout << "-10, " << config.samples << " muestras, " << config.epochs << " epocas, batch " << config.batch << "\n";
+
+    vector<pair<string, Result>> results;
+    results.emplace_back("mse_sgd", run_isolated<MSELoss, SGD>(config, X, Y, 0.1f));
+    results.emplace_back("mse_adam", run_isolated<MSELoss, Adam>(config, X, Y, 0.001f));
+    results.emplace_back("bce_sgd", run_isolated<BCELoss, SGD>(config, X, Y, 0.1f));
+    results.emplace_back("bce_adam", run_isolated<BCELoss, Adam>(config, X, Y, 0.001f));
+
+    bool regression = false;
+    cout << fixed;
+    cout << setw(10) << "combo" << setw(14) << "muestras/s" << setw(12) << "s/epoca"
+         << setw(12) << "pico MB" << setw(12) << "perdida" << setw(12) << "vs ref" << "\n";
+    for (const auto& [name, r] : results) {
+        cout << setw(10) << name << setw(14) << setprecision(0) << r.samples_per_sec
+             << setw(12) << setprecision(3) << r.epoch_seconds << setw(12) << setprecision(1) << r.peak_rss_mb
+             << setw(12) << setprecision(5) << r.final_loss;
+        auto it = baseline.samples_per_sec.find(name);
+        if (it != baseline.samples_per_sec.end() && it->second > 0) {
+            const double change = r.samples_per_sec / it->second - 1.0;
+            cout << setw(11) << setprecision(1) << showpos << change * 100 << noshowpos << "%";
+            if (change < -config.threshold) {
+                cout << "  REGRESION";
+                regression = true;
+            }
+        }
+        cout << "\n";
+    }
+
+    if (!config.output.empty()) {
+        write_json(config.output, config, results);
+        cout << "Resultados guardados en " << config.output << "\n";
+    }
+    return regression ? 1 : 0;
+}
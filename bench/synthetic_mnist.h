@@ -0,0 +1,84 @@
+//
+// Datos y modelos deterministas compartidos por los benchmarks de
+// entrenamiento (no hace falta el CSV de MNIST).
+//
+
+#pragma once
+
+#include <random>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include "utec/neural_network/neural_network.h"
+
+namespace bench {
+
+using utec::algebra::Tensor;
+using utec::neural_network::NeuralNetwork;
+
+// Imágenes 28x28 con forma de MNIST y reproducibles: cada clase tiene un
+// trazo prototipo en el centro; cada muestra lo copia con pixeles perdidos,
+// intensidad variable y algo de ruido de fondo. La mayoría de pixeles son 0.
+// Los prototipos son siempre los mismos; `seed` solo cambia las muestras, así
+// que dos semillas distintas dan entrenamiento y prueba del mismo problema.
+inline void synthetic_mnist(size_t samples, uint32_t seed, Tensor<float, 2>& X, Tensor<float, 2>& Y) {
+    std::mt19937 gen(20250101);
+    std::vector<std::vector<size_t>> prototypes(10);
+    for (auto& p : prototypes) {
+        size_t r = 6 + gen() % 16, c = 6 + gen() % 16;
+        for (size_t step = 0; step < 160; ++step) {
+            p.push_back(r * 28 + c);
+            r = std::clamp<size_t>(r + gen() % 3 - 1, 4, 23);
+            c = std::clamp<size_t>(c + gen() % 3 - 1, 4, 23);
+        }
+    }
+    gen.seed(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    X = Tensor<float, 2>(samples, 784);
+    Y = Tensor<float, 2>(samples, 10);
+    for (size_t i = 0; i < samples; ++i) {
+        const size_t label = gen() % 10;
+        Y(i, label) = 1.0f;
+        for (size_t pixel : prototypes[label])
+            if (unit(gen) < 0.85f) X(i, pixel) = 0.5f + 0.5f * unit(gen);
+        for (size_t k = 0; k < 20; ++k) X(i, gen() % 784) = unit(gen);
+    }
+}
+
+// Escribe X/Y (one-hot) como un CSV con el formato de MNIST: cabecera,
+// etiqueta y 784 pixeles 0-255.
+inline void write_mnist_csv(const std::string& path, const Tensor<float, 2>& X, const Tensor<float, 2>& Y) {
+    std::ofstream out(path);
+    out << "label";
+    for (size_t j = 0; j < X.shape()[1]; ++j) out << ",p" << j;
+    out << "\n";
+    for (size_t i = 0; i < X.shape()[0]; ++i) {
+        size_t label = 0;
+        for (size_t j = 0; j < Y.shape()[1]; ++j)
+            if (Y(i, j) == 1.0f) label = j;
+        out << label;
+        for (size_t j = 0; j < X.shape()[1]; ++j) out << "," << static_cast<int>(X(i, j) * 255.0f);
+        out << "\n";
+    }
+}
+
+inline NeuralNetwork<float> build_mlp(const std::vector<size_t>& hidden, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(-0.1f, 0.1f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+    auto zero = [](Tensor<float, 2>& t) { t.fill(0.0f); };
+
+    NeuralNetwork<float> nn;
+    size_t in = 784;
+    for (size_t width : hidden) {
+        nn.add_layer(std::make_unique<utec::neural_network::Dense<float>>(in, width, init, zero));
+        nn.add_layer(std::make_unique<utec::neural_network::ReLU<float>>());
+        in = width;
+    }
+    nn.add_layer(std::make_unique<utec::neural_network::Dense<float>>(in, 10, init, zero));
+    nn.add_layer(std::make_unique<utec::neural_network::Sigmoid<float>>());
+    return nn;
+}
+
+} // namespace bench
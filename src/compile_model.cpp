@@ -0,0 +1,162 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::neural_network;
+using namespace std;
+
+// Compilador AOT: lee un modelo guardado (texto o binario) y genera un header
+// C++ autónomo con los pesos como arreglos estáticos alineados y una función
+// forward especializada para las dimensiones exactas de la red: sin
+// dispatch virtual, sin heap y sin chequeos de forma en tiempo de ejecución.
+// Las activaciones se fusionan en la salida del Dense anterior.
+
+namespace {
+
+struct Step {
+    enum Kind { DenseStep, ReLUStep, SigmoidStep } kind;
+    const Dense<float>* dense = nullptr;
+};
+
+void write_array(ostream& out, const string& name, const float* data, size_t n) {
+    out << "alignas(64) static const float " << name << "[" << n << "] = {";
+    out << hexfloat;
+    for (size_t i = 0; i < n; ++i) {
+        if (i % 8 == 0) out << "\n    ";
+        out << data[i] << "f" << (i + 1 < n ? ", " : "");
+    }
+    out << defaultfloat << "\n};\n\n";
+}
+
+string activation_expr(Step::Kind kind, const string& value) {
+    switch (kind) {
+    case Step::ReLUStep: return "(" + value + " > 0.0f ? " + value + " : 0.0f)";
+    case Step::SigmoidStep: return "1.0f / (1.0f + std::exp(-" + value + "))";
+    default: return value;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Uso: " << argv[0] << " <modelo> <salida.h> [namespace]" << endl;
+        return 1;
+    }
+    const string input = argv[1];
+    const string output = argv[2];
+    const string ns = argc > 3 ? argv[3] : "compiled_model";
+
+    NeuralNetwork<float> nn;
+    nn.load(input);
+
+    vector<Step> steps;
+    for (const auto& layer : nn.dlayers()) {
+        if (auto dense = dynamic_cast<Dense<float>*>(layer.get())) steps.push_back({Step::DenseStep, dense});
+        else if (dynamic_cast<ReLU<float>*>(layer.get())) steps.push_back({Step::ReLUStep});
+        else if (dynamic_cast<Sigmoid<float>*>(layer.get())) steps.push_back({Step::SigmoidStep});
+        else {
+            cerr << "Error: capa no soportada por el compilador" << endl;
+            return 1;
+        }
+    }
+    if (steps.empty() || steps.front().kind != Step::DenseStep) {
+        cerr << "Error: el modelo debe empezar con una capa Dense" << endl;
+        return 1;
+    }
+
+    ostringstream weights, body;
+    size_t width = steps.front().dense->in_features();
+    const size_t input_size = width;
+    string current = "x";
+    size_t dense_index = 0, buffer_index = 0;
+
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const Step& step = steps[i];
+        const bool last = i + 1 == steps.size();
+
+        if (step.kind == Step::DenseStep) {
+            const size_t in_f = step.dense->in_features();
+            const size_t out_f = step.dense->out_features();
+            if (in_f != width) {
+                cerr << "Error: dimensiones incompatibles entre capas" << endl;
+                return 1;
+            }
+            const string w = "W" + to_string(dense_index), b = "B" + to_string(dense_index);
+            write_array(weights, w, step.dense->weights_data(), in_f * out_f);
+            write_array(weights, b, step.dense->biases_data(), out_f);
+
+            // La activación siguiente se aplica al escribir la salida.
+            Step::Kind fused = Step::DenseStep;
+            if (!last && steps[i + 1].kind != Step::DenseStep) {
+                fused = steps[i + 1].kind;
+                ++i;
+            }
+            const bool writes_output = i + 1 == steps.size();
+            const string target = writes_output ? "y" : "h" + to_string(buffer_index);
+
+            body << "    // Dense " << dense_index << ": " << in_f << " -> " << out_f << "\n";
+            if (!writes_output)
+                body << "    alignas(64) float " << target << "[" << out_f << "];\n";
+            body << "    {\n"
+                 << "        alignas(64) float acc[" << out_f << "] = {};\n"
+                 << "        for (std::size_t k = 0; k < " << in_f << "; ++k) {\n"
+                 << "            const float a = " << current << "[k];\n"
+                 << "            const float* w = " << w << " + k * " << out_f << ";\n"
+                 << "            for (std::size_t j = 0; j < " << out_f << "; ++j)\n"
+                 << "                acc[j] += a * w[j];\n"
+                 << "        }\n"
+                 << "        for (std::size_t j = 0; j < " << out_f << "; ++j) {\n"
+                 << "            const float z = acc[j] + " << b << "[j];\n"
+                 << "            " << target << "[j] = " << activation_expr(fused, "z") << ";\n"
+                 << "        }\n"
+                 << "    }\n";
+            current = target;
+            width = out_f;
+            ++dense_index;
+            if (!writes_output) ++buffer_index;
+        } else {
+            const string target = last ? "y" : "h" + to_string(buffer_index);
+            if (!last)
+                body << "    alignas(64) float " << target << "[" << width << "];\n";
+            body << "    for (std::size_t j = 0; j < " << width << "; ++j) {\n"
+                 << "        const float z = " << current << "[j];\n"
+                 << "        " << target << "[j] = " << activation_expr(step.kind, "z") << ";\n"
+                 << "    }\n";
+            current = target;
+            if (!last) ++buffer_index;
+        }
+    }
+
+    ofstream out(output);
+    if (!out) {
+        cerr << "Error: no se pudo escribir " << output << endl;
+        return 1;
+    }
+    out << "// Generado por proyecto_final_compile a partir de " << input << ". No editar.\n"
+        << "#pragma once\n\n"
+        << "#include <cstddef>\n"
+        << "#include <cmath>\n\n"
+        << "namespace " << ns << " {\n\n"
+        << "constexpr std::size_t INPUT_SIZE = " << input_size << ";\n"
+        << "constexpr std::size_t OUTPUT_SIZE = " << width << ";\n\n"
+        << weights.str()
+        << "// x: INPUT_SIZE valores, y: OUTPUT_SIZE valores.\n"
+        << "inline void forward(const float* x, float* y) noexcept {\n"
+        << body.str()
+        << "}\n\n"
+        << "// n muestras contiguas (fila por muestra).\n"
+        << "inline void forward_batch(const float* x, float* y, std::size_t n) noexcept {\n"
+        << "    for (std::size_t i = 0; i < n; ++i)\n"
+        << "        forward(x + i * INPUT_SIZE, y + i * OUTPUT_SIZE);\n"
+        << "}\n\n"
+        << "} // namespace " << ns << "\n";
+
+    cout << "Modelo compilado en " << output << " (" << dense_index << " capas Dense, "
+         << input_size << " -> " << width << ")" << endl;
+    return 0;
+}
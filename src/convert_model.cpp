@@ -0,0 +1,69 @@
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::neural_network;
+using namespace std;
+
+// Convierte un modelo en texto (modelo.nn) al formato binario mapeable.
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Uso: " << argv[0] << " <modelo_texto> <modelo_binario>" << endl;
+        return 1;
+    }
+    const string input = argv[1];
+    const string output = argv[2];
+
+    if (!ifstream(input)) {
+        cerr << "Error: no se pudo abrir " << input << endl;
+        return 1;
+    }
+    NeuralNetwork<float> text_model;
+    auto start = chrono::high_resolution_clock::now();
+    text_model.load(input);
+    auto end = chrono::high_resolution_clock::now();
+    double text_ms = chrono::duration<double, milli>(end - start).count();
+    if (text_model.dlayers().empty()) {
+        cerr << "Error: " << input << " no tiene capas" << endl;
+        return 1;
+    }
+
+    text_model.save_binary(output);
+
+    NeuralNetwork<float> binary_model;
+    start = chrono::high_resolution_clock::now();
+    binary_model.load_binary(output);
+    end = chrono::high_resolution_clock::now();
+    double binary_ms = chrono::duration<double, milli>(end - start).count();
+
+    // Verificación: mismas capas y mismos pesos bit a bit.
+    const auto& a = text_model.dlayers();
+    const auto& b = binary_model.dlayers();
+    if (a.size() != b.size()) {
+        cerr << "Error: distinto numero de capas" << endl;
+        return 1;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        auto da = dynamic_cast<Dense<float>*>(a[i].get());
+        auto db = dynamic_cast<Dense<float>*>(b[i].get());
+        if (!da) continue;
+        size_t n = da->in_features() * da->out_features();
+        if (!db || db->in_features() != da->in_features() || db->out_features() != da->out_features()
+            || memcmp(da->weights_data(), db->weights_data(), n * sizeof(float)) != 0
+            || memcmp(da->biases_data(), db->biases_data(), da->out_features() * sizeof(float)) != 0) {
+            cerr << "Error: la capa " << i << " no coincide" << endl;
+            return 1;
+        }
+    }
+
+    cout << "Capas: " << a.size() << endl;
+    cout << "Texto:   " << filesystem::file_size(input) << " bytes, carga " << text_ms << " ms" << endl;
+    cout << "Binario: " << filesystem::file_size(output) << " bytes, carga " << binary_ms << " ms" << endl;
+    cout << "Modelo convertido en " << output << endl;
+    return 0;
+}
@@ -1,25 +1,24 @@
 #include <iostream>
 #include <memory>
-#include <random>
 #include <chrono>
+#include <filesystem>
+#include <numeric>
 
 #include "utec/algebra/tensor.h"
 #include "utec/neural_network/neural_network.h"
+#include "utec/neural_network/nn_metrics.h"
 #include "utec/neural_network/nn_dense.h"
 #include "utec/neural_network/nn_activation.h"
 #include "utec/neural_network/nn_loss.h"
 #include "utec/neural_network/nn_optimizer.h"
 #include "utec/neural_network/data/mnist_loader.h"
+#include "utec/neural_network/data/prefetch_loader.h"
+#include "utec/neural_network/data/mnist_stream.h"
+#include "utec/neural_network/data/augmentation.h"
 
 using namespace utec::algebra;
 using namespace utec::neural_network;
 using namespace std;
-float random_weight() {
-    static mt19937 gen(random_device{}());
-    static uniform_real_distribution<float> dist(-0.1f, 0.1f);
-    return dist(gen);
-}
-
 Tensor<float, 2> vector2D_to_tensor(const vector<vector<float>>& data) {
     size_t rows = data.size();
     size_t cols = data[0].size();
@@ -30,53 +29,81 @@ Tensor<float, 2> vector2D_to_tensor(const vector<vector<float>>& data) {
     return tensor;
 }
 
-Tensor<float, 2> labels_to_onehot(const vector<int>& labels, int num_classes) {
-    size_t rows = labels.size();
-    Tensor<float, 2> tensor(array<size_t, 2>{rows, static_cast<size_t>(num_classes)});
-    tensor.fill(0.0f);
-    for (size_t i = 0; i < rows; ++i)
-        tensor(i, labels[i]) = 1.0f;
-    return tensor;
-}
+// Con --stream el entrenamiento lee el CSV por bloques (MNISTStream, memoria
+// fija) en vez de usar la copia que guarda MNISTLoader: el CSV de
+// entrenamiento nunca se carga entero, solo las filas de validación. Con --augment cada
+// batch pasa por el aumento de datos (desplazamiento, rotación, escala y
+// distorsión elástica) en el hilo de prefetch.
+int main(int argc, char* argv[]) {
+    bool use_stream = false, augment = false;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--stream") use_stream = true;
+        if (string(argv[i]) == "--augment") augment = true;
+    }
+    if (use_stream && augment) {
+        cerr << "--augment solo funciona con el loader en memoria" << endl;
+        return 1;
+    }
 
-int main() {
+    const string train_path = "mnist/mnist_train.csv";
     MNISTLoader loader;
 
     cout << "Cargando datos..." << endl;
-    loader.loadTrainData("mnist/mnist_train.csv");
+    if (!use_stream) loader.loadTrainData(train_path);
     loader.loadTestData("mnist/mnist_test.csv");
 
-    auto [train_images, train_labels] = loader.getTrainData();
     auto [test_images, test_labels] = loader.getTestData();
 
-    auto X_train = vector2D_to_tensor(train_images);
-    auto Y_train = labels_to_onehot(train_labels, 10);
-
     auto X_test = vector2D_to_tensor(test_images);
-    auto Y_test = labels_to_onehot(test_labels, 10);
 
-    cout << "Tamanio entrenamiento: " << train_images.size() << endl;
+    // Las últimas muestras de entrenamiento se reservan para validación:
+    // deciden cuándo parar sin mirar el conjunto de prueba. Con --stream se
+    // cuentan las filas y se leen solo esas del CSV.
+    const size_t validation_size = 5000;
+    const size_t total_size = use_stream ? MNISTStream<float>::count_rows(train_path)
+                                         : static_cast<size_t>(loader.getTrainSize());
+    if (total_size <= validation_size) {
+        cerr << "Se necesitan mas de " << validation_size << " muestras de entrenamiento" << endl;
+        return 1;
+    }
+    const size_t train_size = total_size - validation_size;
+    Tensor<float, 2> X_val(validation_size, 784), Y_val(validation_size, 10);
+    if (use_stream) {
+        MNISTStream<float>::read_rows(train_path, train_size, X_val, Y_val);
+    } else {
+        vector<size_t> indices(validation_size);
+        iota(indices.begin(), indices.end(), train_size);
+        loader.gatherBatch(indices.data(), validation_size, X_val.data.data(), Y_val.data.data());
+    }
+
+    cout << "Tamanio entrenamiento: " << train_size << endl;
+    cout << "Tamanio validacion: " << validation_size << endl;
     cout << "Tamanio prueba: " << test_images.size() << endl;
 
     NeuralNetwork<float> nn;
 
+    // Pesos reproducibles: un flujo Philox por capa, llenado en paralelo con
+    // el mismo resultado sin importar los hilos. He para las capas seguidas
+    // de ReLU, Xavier para la de salida (sigmoide).
+    const rng::Stream init_stream(2025);
+
     nn.add_layer(make_unique<Dense<float>>(
         784, 128,
-        [](auto& w){ for (auto& val : w) val = random_weight(); },
+        rng::he_uniform(init_stream.split(0)),
         [](auto& b){ b.fill(0.0f); }
     ));
     nn.add_layer(make_unique<ReLU<float>>());
 
     nn.add_layer(make_unique<Dense<float>>(
         128, 64,
-        [](auto& w){ for (auto& val : w) val = random_weight(); },
+        rng::he_uniform(init_stream.split(1)),
         [](auto& b){ b.fill(0.0f); }
     ));
     nn.add_layer(make_unique<ReLU<float>>());
 
     nn.add_layer(make_unique<Dense<float>>(
         64, 10,
-        [](auto& w){ for (auto& val : w) val = random_weight(); },
+        rng::xavier_uniform(init_stream.split(2)),
         [](auto& b){ b.fill(0.0f); }
     ));
     nn.add_layer(make_unique<Sigmoid<float>>());
@@ -90,38 +117,86 @@ int main() {
     size_t batch_size = 64;
     float learning_rate = 0.01f;
 
-    for (size_t epoch = 0; epoch < epochs; ++epoch) {
-        nn.train<BCELoss, Adam>(X_train, Y_train, 1, batch_size, learning_rate);
+    // Se detiene si la pérdida de validación no mejora en 5 épocas y vuelve
+    // a los pesos de la mejor.
+    nn.set_validation(X_val, Y_val);
+    nn.enable_early_stopping(EarlyStopping(5, 1e-4));
+
+    // Si quedó un checkpoint de una corrida interrumpida, se retoma desde ahí
+    // (pesos, momentos de Adam, contador de pasos, posición del loader,
+    // historial y progreso de la parada temprana).
+    const string checkpoint_path = "modelo.ckpt";
+    TrainingState resume;
+    if (filesystem::exists(checkpoint_path)) {
+        resume = nn.load_checkpoint(checkpoint_path);
+        cout << "Reanudando desde la epoca " << resume.epoch + 1 << ", batch " << resume.batch << endl;
+    }
+    nn.enable_checkpoints(checkpoint_path, 500);
+
+    // El siguiente batch se arma en segundo plano mientras la red entrena.
+    // Los pixeles quedan en uint8 dentro del loader y se convierten a float
+    // normalizado recién al armar cada batch. El stream no tiene posición
+    // reanudable: con un checkpoint retoma desde el inicio de la época.
+    unique_ptr<PrefetchLoader<float>> train_loader;
+    unique_ptr<MNISTStream<float>> train_stream;
+    unique_ptr<AugmentationPipeline<float>> augmentation;
+    if (use_stream) {
+        train_stream = make_unique<MNISTStream<float>>(train_path, batch_size);
+        train_stream->limit_rows(train_size);
+    } else {
+        PrefetchLoader<float>::GatherFn gather =
+            [&loader](const size_t* idx, size_t n, float* x, float* y) { loader.gatherBatch(idx, n, x, y); };
+        if (augment) {
+            augmentation = make_unique<AugmentationPipeline<float>>();
+            gather = augmentation->wrap(gather);
+        }
+        train_loader = make_unique<PrefetchLoader<float>>(
+            train_size, 784, 10, batch_size, gather, 2, false, 42, resume.loader_state);
+    }
 
+    nn.on_epoch([epochs](const EpochStats<float>& stats) {
+        cout << "Epoca " << stats.epoch << "/" << epochs << ": perdida " << stats.train_loss;
+        if (stats.validated) cout << ", validacion " << stats.validation_loss;
+        cout << " (" << stats.seconds << " s)\n";
+        return true;
+    });
 
-        if ((epoch+1) % 10 == 0 || epoch == epochs-1) {
-            cout << "Epoca " << (epoch+1) << "/" << epochs << " completada\n";
-        }
+    if (resume.epoch < epochs) {
+        if (train_stream) nn.train<BCELoss, Adam>(*train_stream, epochs - resume.epoch, learning_rate);
+        else nn.train<BCELoss, Adam>(*train_loader, epochs - resume.epoch, learning_rate);
+    }
+    if (nn.stopped_early()) {
+        cout << "Parada temprana en la epoca " << nn.training_state().epoch << "\n";
     }
 
     auto end = chrono::high_resolution_clock::now();
     chrono::duration<double> elapsed = end - start;
     cout << "Entrenamiento terminado en " << elapsed.count() << " segundos\n";
 
-    cout << "Evaluando en conjunto de prueba..." << endl;
-    auto Y_pred = nn.predict(X_test);
-
-    int correct = 0;
-    for (size_t i = 0; i < Y_pred.shape()[0]; ++i) {
-        int pred_label = 0;
-        float max_val = Y_pred(i, 0);
-        for (int j = 1; j < 10; ++j) {
-            if (Y_pred(i, j) > max_val) {
-                max_val = Y_pred(i, j);
-                pred_label = j;
-            }
-        }
-        if (pred_label == test_labels[i])
-            ++correct;
+#ifdef UTEC_NN_PROFILE
+    profiler::Profiler::instance().summary(cout);
+    profiler::Profiler::instance().write_chrome_trace("perfil.json");
+    cout << "Traza del profiler guardada en perfil.json\n";
+#endif
+
+    // El entrenamiento terminó: el checkpoint ya no hace falta.
+    nn.flush_checkpoints();
+    filesystem::remove(checkpoint_path);
+
+    if (train_stream) {
+        const auto& stats = train_stream->stats();
+        cout << "Stream: " << stats.samples << " muestras, " << stats.mb_per_s() << " MB/s, "
+             << stats.samples_per_s() << " muestras/s, memoria " << train_stream->memory_ceiling() / 1024 << " KB\n";
+    } else {
+        auto stats = train_loader->stats();
+        cout << "Prefetch: " << stats.batches << " batches, espera del entrenamiento "
+             << stats.consumer_wait << " s, espera del productor " << stats.producer_wait
+             << " s, armado " << stats.produce_time << " s\n";
     }
 
-    float accuracy = static_cast<float>(correct) / test_labels.size() * 100.0f;
-    cout << "Precision en prueba: " << accuracy << " %" << endl;
+    cout << "Evaluando en conjunto de prueba..." << endl;
+    auto metrics = evaluate(nn, X_test, test_labels, 10);
+    cout << "Precision en prueba: " << metrics.accuracy() * 100.0 << " %" << endl;
 
 
     ofstream out("modelo.nn");
@@ -137,5 +212,8 @@ int main() {
     }
     out.close();
     cout << "Modelo guardado en modelo.nn\n";
+
+    nn.save_binary("modelo.nnb");
+    cout << "Modelo binario guardado en modelo.nnb\n";
     return 0;
 }
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <numeric>
+
+#include "utec/neural_network/neural_network.h"
+#include "utec/neural_network/nn_sweep.h"
+#include "utec/neural_network/data/mnist_loader.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Barrido de tasa de aprendizaje, tamaño de batch y capas ocultas sobre
+// MNIST en un solo proceso: el CSV se lee una vez y todas las
+// configuraciones entrenan sobre los mismos tensores.
+//
+//   proyecto_final_sweep [hilos] [rondas] [epocas_iniciales]
+int main(int argc, char* argv[]) {
+    SweepOptions options;
+    options.workers = argc > 1 ? stoul(argv[1]) : 0;
+    options.rungs = argc > 2 ? stoul(argv[2]) : 3;
+    options.min_epochs = argc > 3 ? stoul(argv[3]) : 1;
+
+    MNISTLoader loader;
+    cout << "Cargando datos..." << endl;
+    const auto load_start = chrono::steady_clock::now();
+    if (!loader.loadTrainData("mnist/mnist_train.csv") || loader.getTrainSize() <= 5000) {
+        cerr << "Error: se necesita mnist/mnist_train.csv" << endl;
+        return 1;
+    }
+
+    // Igual que en el entrenamiento: las últimas 5000 muestras validan.
+    const size_t validation_size = 5000;
+    const size_t train_size = loader.getTrainSize() - validation_size;
+    Tensor<float, 2> X(train_size, 784), Y(train_size, 10), X_val(validation_size, 784), Y_val(validation_size, 10);
+    {
+        vector<size_t> indices(loader.getTrainSize());
+        iota(indices.begin(), indices.end(), size_t(0));
+        loader.gatherBatch(indices.data(), train_size, X.data.data(), Y.data.data());
+        loader.gatherBatch(indices.data() + train_size, validation_size, X_val.data.data(), Y_val.data.data());
+    }
+    const double load_seconds = chrono::duration<double>(chrono::steady_clock::now() - load_start).count();
+    cout << "Datos listos en " << load_seconds << " s (" << (X.size() + Y.size() + X_val.size() + Y_val.size()) * sizeof(float) / (1024 * 1024)
+         << " MB compartidos por todas las configuraciones)" << endl;
+
+    auto trials = sweep_grid<float>({0.001f, 0.003f, 0.01f}, {32, 64, 128}, {{64}, {128}, {128, 64}, {256, 128}});
+    cout << trials.size() << " configuraciones, " << options.rungs << " rondas" << endl;
+
+    SweepRunner<float> runner(X, Y, X_val, Y_val, sweep_mlp<float>(784, 10));
+    const auto start = chrono::steady_clock::now();
+    const auto results = runner.run<BCELoss, Adam>(trials, options);
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    write_sweep_table(cout, results);
+    ofstream csv("barrido.csv");
+    write_sweep_table(csv, results, true);
+    cout << "Barrido terminado en " << seconds << " s; tabla guardada en barrido.csv\n";
+
+    if (auto best = runner.best()) {
+        best->save("mejor_modelo.nn");
+        cout << "Mejor configuracion: " << results.front().id << ", guardada en mejor_modelo.nn\n";
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+//
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2,
+// 3", SC 2011): generador basado en contador. Cada bloque de 4 palabras de
+// 32 bits es una función pura de (contador, flujo, clave), así que cualquier
+// tramo se puede generar en cualquier orden y en cualquier hilo con el mismo
+// resultado. La ruta AVX2 calcula 8 bloques a la vez y da los mismos bits
+// que la escalar.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_PHILOX_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_PHILOX_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace utec::algebra::philox {
+
+constexpr uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+constexpr uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+constexpr int ROUNDS = 10;
+
+// Bloque `counter` del flujo `stream` con clave `key`.
+inline std::array<uint32_t, 4> block(uint64_t counter, uint64_t stream, uint64_t key) {
+    uint32_t c0 = uint32_t(counter), c1 = uint32_t(counter >> 32);
+    uint32_t c2 = uint32_t(stream), c3 = uint32_t(stream >> 32);
+    uint32_t k0 = uint32_t(key), k1 = uint32_t(key >> 32);
+    for (int r = 0; r < ROUNDS; ++r) {
+        if (r > 0) {
+            k0 += W0;
+            k1 += W1;
+        }
+        const uint64_t p0 = uint64_t(M0) * c0, p1 = uint64_t(M1) * c2;
+        const uint32_t n0 = uint32_t(p1 >> 32) ^ c1 ^ k0, n2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+        c1 = uint32_t(p1);
+        c3 = uint32_t(p0);
+        c0 = n0;
+        c2 = n2;
+    }
+    return {c0, c1, c2, c3};
+}
+
+#if defined(__AVX2__)
+namespace detail {
+    // Partes baja y alta de a * m para 8 carriles de 32 bits.
+    inline void mulhilo(__m256i a, __m256i m, __m256i& lo, __m256i& hi) {
+        const __m256i even = _mm256_mul_epu32(a, m);
+        const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+        lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+        hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    }
+}
+#endif
+
+// out[0 .. 4 * blocks) = bloques first, first + 1, ... (4 palabras cada uno).
+inline void fill_blocks(uint32_t* out, size_t blocks, uint64_t first, uint64_t stream, uint64_t key) {
+    size_t b = 0;
+#if defined(__AVX2__)
+    const __m256i m0 = _mm256_set1_epi32(int(M0)), m1 = _mm256_set1_epi32(int(M1));
+    const __m256i s_lo = _mm256_set1_epi32(int(uint32_t(stream))), s_hi = _mm256_set1_epi32(int(uint32_t(stream >> 32)));
+    for (; b + 8 <= blocks; b += 8) {
+        alignas(32) uint32_t lo[8], hi[8];
+        for (int j = 0; j < 8; ++j) {
+            const uint64_t counter = first + b + j;
+            lo[j] = uint32_t(counter);
+            hi[j] = uint32_t(counter >> 32);
+        }
+        __m256i c0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lo));
+        __m256i c1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(hi));
+        __m256i c2 = s_lo, c3 = s_hi;
+        uint32_t k0 = uint32_t(key), k1 = uint32_t(key >> 32);
+        for (int r = 0; r < ROUNDS; ++r) {
+            if (r > 0) {
+                k0 += W0;
+                k1 += W1;
+            }
+            __m256i lo0, hi0, lo1, hi1;
+            detail::mulhilo(c0, m0, lo0, hi0);
+            detail::mulhilo(c2, m1, lo1, hi1);
+            const __m256i n0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(int(k0)));
+            const __m256i n2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(int(k1)));
+            c1 = lo1;
+            c3 = lo0;
+            c0 = n0;
+            c2 = n2;
+        }
+        alignas(32) uint32_t w[4][8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(w[0]), c0);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(w[1]), c1);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(w[2]), c2);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(w[3]), c3);
+        for (int j = 0; j < 8; ++j)
+            for (int k = 0; k < 4; ++k) out[(b + j) * 4 + k] = w[k][j];
+    }
+#endif
+    for (; b < blocks; ++b) {
+        const auto words = block(first + b, stream, key);
+        for (int k = 0; k < 4; ++k) out[b * 4 + k] = words[k];
+    }
+}
+
+// out[0 .. n) = palabras first_word, first_word + 1, ... del flujo (la
+// palabra i es la i % 4 del bloque i / 4), sin importar el alineamiento.
+inline void fill_words(uint32_t* out, size_t n, uint64_t first_word, uint64_t stream, uint64_t key) {
+    while (n > 0 && first_word % 4 != 0) {
+        *out++ = block(first_word / 4, stream, key)[first_word % 4];
+        ++first_word;
+        --n;
+    }
+    const size_t blocks = n / 4;
+    fill_blocks(out, blocks, first_word / 4, stream, key);
+    out += blocks * 4;
+    first_word += blocks * 4;
+    for (size_t i = 0; i < n % 4; ++i) out[i] = block(first_word / 4, stream, key)[i];
+}
+
+} // namespace utec::algebra::philox
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_PHILOX_H
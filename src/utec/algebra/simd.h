@@ -0,0 +1,234 @@
+//
+// Kernels vectorizados pequeños. Cada uno tiene ruta AVX2/SSE cuando el
+// compilador la habilita (-mavx2, /arch:AVX2) y una ruta escalar equivalente.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_SIMD_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace utec
+{
+    namespace algebra
+    {
+        namespace simd
+        {
+            // dst[i] = src[i] * a + b  (uint8 -> float en una sola pasada)
+            inline void dequantize_u8(const uint8_t* src, float* dst, size_t n, float a, float b) {
+                size_t i = 0;
+#if defined(__AVX2__)
+                const __m256 va = _mm256_set1_ps(a);
+                const __m256 vb = _mm256_set1_ps(b);
+                for (const size_t end = n - n % 8; i < end; i += 8) {
+                    __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+                    __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes));
+                    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_mul_ps(f, va), vb));
+                }
+#elif defined(__SSE4_1__)
+                const __m128 va = _mm_set1_ps(a);
+                const __m128 vb = _mm_set1_ps(b);
+                for (const size_t end = n - n % 4; i < end; i += 4) {
+                    int32_t packed;
+                    std::memcpy(&packed, src + i, sizeof(packed));
+                    __m128 f = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed)));
+                    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(f, va), vb));
+                }
+#endif
+                for (; i < n; ++i) {
+                    dst[i] = static_cast<float>(src[i]) * a + b;
+                }
+            }
+
+            // Producto punto de activaciones uint8 en [0, 127] por pesos int8 con
+            // acumulación int32. Con entradas de 7 bits la suma de pares de
+            // maddubs no satura, así que todas las rutas dan el mismo resultado.
+            // `k` debe ser múltiplo de 32 (rellenar con ceros).
+            inline int32_t dot_u8s8(const uint8_t* a, const int8_t* b, size_t k) {
+#if defined(__AVX2__)
+                __m256i acc = _mm256_setzero_si256();
+#if !(defined(__AVX512VNNI__) && defined(__AVX512VL__)) && !defined(__AVXVNNI__)
+                const __m256i ones = _mm256_set1_epi16(1);
+#endif
+                for (size_t i = 0; i < k; i += 32) {
+                    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+                    acc = _mm256_dpbusd_epi32(acc, va, vb);
+#elif defined(__AVXVNNI__)
+                    acc = _mm256_dpbusd_avx_epi32(acc, va, vb);
+#else
+                    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_maddubs_epi16(va, vb), ones));
+#endif
+                }
+                __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+                sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+                sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+                return _mm_cvtsi128_si32(sum);
+#else
+                int32_t acc = 0;
+                for (size_t i = 0; i < k; ++i) {
+                    acc += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+                }
+                return acc;
+#endif
+            }
+
+            // Índice del primer máximo de x[0..n) (mismo criterio que un
+            // recorrido escalar con `>`).
+            inline size_t argmax(const float* x, size_t n) {
+                size_t i = 0, best = 0;
+                float best_value = n ? x[0] : 0.0f;
+#if defined(__AVX2__)
+                if (n >= 8) {
+                    __m256 values = _mm256_loadu_ps(x);
+                    __m256i indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+                    __m256i current = indices;
+                    const __m256i step = _mm256_set1_epi32(8);
+                    for (i = 8; i + 8 <= n; i += 8) {
+                        current = _mm256_add_epi32(current, step);
+                        const __m256 v = _mm256_loadu_ps(x + i);
+                        const __m256 greater = _mm256_cmp_ps(v, values, _CMP_GT_OQ);
+                        values = _mm256_blendv_ps(values, v, greater);
+                        indices = _mm256_castps_si256(_mm256_blendv_ps(
+                            _mm256_castsi256_ps(indices), _mm256_castsi256_ps(current), greater));
+                    }
+                    // Cada carril guarda su primer máximo; entre carriles empatados
+                    // gana el índice menor.
+                    alignas(32) float lane_values[8];
+                    alignas(32) int32_t lane_indices[8];
+                    _mm256_store_ps(lane_values, values);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(lane_indices), indices);
+                    best_value = lane_values[0];
+                    best = static_cast<size_t>(lane_indices[0]);
+                    for (size_t l = 1; l < 8; ++l) {
+                        const size_t idx = static_cast<size_t>(lane_indices[l]);
+                        if (lane_values[l] > best_value || (lane_values[l] == best_value && idx < best)) {
+                            best_value = lane_values[l];
+                            best = idx;
+                        }
+                    }
+                }
+#endif
+                for (; i < n; ++i) {
+                    if (x[i] > best_value) {
+                        best_value = x[i];
+                        best = i;
+                    }
+                }
+                return best;
+            }
+
+            // Micro-kernel de GEMM sobre un panel de 16 columnas (ver
+            // InferencePlan): acc (R x 16) = x (R x k, paso ldx) * panel (k x 16).
+            // Multiplica y suma por separado (sin FMA) en el mismo orden que
+            // matrix_product, así el resultado coincide bit a bit con él.
+#if defined(__AVX2__)
+            constexpr size_t PANEL_ROWS = 4;
+#else
+            constexpr size_t PANEL_ROWS = 2;
+#endif
+
+            template<size_t R>
+            inline void gemm_panel16(const float* x, size_t ldx, const float* panel, size_t k, float* acc) {
+#if defined(__AVX2__)
+                __m256 c0[R], c1[R];
+                for (size_t r = 0; r < R; ++r) c0[r] = c1[r] = _mm256_setzero_ps();
+                for (size_t i = 0; i < k; ++i) {
+                    const __m256 w0 = _mm256_loadu_ps(panel + i * 16);
+                    const __m256 w1 = _mm256_loadu_ps(panel + i * 16 + 8);
+                    for (size_t r = 0; r < R; ++r) {
+                        const __m256 a = _mm256_set1_ps(x[r * ldx + i]);
+                        c0[r] = _mm256_add_ps(c0[r], _mm256_mul_ps(a, w0));
+                        c1[r] = _mm256_add_ps(c1[r], _mm256_mul_ps(a, w1));
+                    }
+                }
+                for (size_t r = 0; r < R; ++r) {
+                    _mm256_storeu_ps(acc + r * 16, c0[r]);
+                    _mm256_storeu_ps(acc + r * 16 + 8, c1[r]);
+                }
+#elif defined(__SSE2__)
+                __m128 c[R][4];
+                for (size_t r = 0; r < R; ++r)
+                    for (size_t q = 0; q < 4; ++q) c[r][q] = _mm_setzero_ps();
+                for (size_t i = 0; i < k; ++i) {
+                    const float* w = panel + i * 16;
+                    const __m128 w0 = _mm_loadu_ps(w), w1 = _mm_loadu_ps(w + 4);
+                    const __m128 w2 = _mm_loadu_ps(w + 8), w3 = _mm_loadu_ps(w + 12);
+                    for (size_t r = 0; r < R; ++r) {
+                        const __m128 a = _mm_set1_ps(x[r * ldx + i]);
+                        c[r][0] = _mm_add_ps(c[r][0], _mm_mul_ps(a, w0));
+                        c[r][1] = _mm_add_ps(c[r][1], _mm_mul_ps(a, w1));
+                        c[r][2] = _mm_add_ps(c[r][2], _mm_mul_ps(a, w2));
+                        c[r][3] = _mm_add_ps(c[r][3], _mm_mul_ps(a, w3));
+                    }
+                }
+                for (size_t r = 0; r < R; ++r)
+                    for (size_t q = 0; q < 4; ++q) _mm_storeu_ps(acc + r * 16 + q * 4, c[r][q]);
+#else
+                for (size_t j = 0; j < R * 16; ++j) acc[j] = 0.0f;
+                for (size_t i = 0; i < k; ++i)
+                    for (size_t r = 0; r < R; ++r) {
+                        const float a = x[r * ldx + i];
+                        for (size_t j = 0; j < 16; ++j) acc[r * 16 + j] += a * panel[i * 16 + j];
+                    }
+#endif
+            }
+
+            // GEMV sobre paneles de 16 columnas: y[p*16 .. p*16+16) = x (1 x k) *
+            // panel p, con los paneles separados por `stride` floats. Recorre
+            // varios paneles a la vez para tener cadenas de suma independientes.
+            inline void gemv_panels16(const float* x, const float* panels, size_t stride, size_t count,
+                                      size_t k, float* y) {
+                size_t p = 0;
+#if defined(__AVX2__)
+                for (; p + 4 <= count; p += 4) {
+                    const float* w = panels + p * stride;
+                    __m256 c[8];
+                    for (auto& v : c) v = _mm256_setzero_ps();
+                    for (size_t i = 0; i < k; ++i) {
+                        const __m256 a = _mm256_set1_ps(x[i]);
+                        for (size_t q = 0; q < 4; ++q) {
+                            const float* wq = w + q * stride + i * 16;
+                            c[2 * q] = _mm256_add_ps(c[2 * q], _mm256_mul_ps(a, _mm256_loadu_ps(wq)));
+                            c[2 * q + 1] = _mm256_add_ps(c[2 * q + 1], _mm256_mul_ps(a, _mm256_loadu_ps(wq + 8)));
+                        }
+                    }
+                    for (size_t q = 0; q < 8; ++q) _mm256_storeu_ps(y + p * 16 + q * 8, c[q]);
+                }
+#elif defined(__SSE2__)
+                for (; p + 2 <= count; p += 2) {
+                    const float* w = panels + p * stride;
+                    __m128 c[8];
+                    for (auto& v : c) v = _mm_setzero_ps();
+                    for (size_t i = 0; i < k; ++i) {
+                        const __m128 a = _mm_set1_ps(x[i]);
+                        for (size_t q = 0; q < 8; ++q) {
+                            const float* wq = w + (q / 4) * stride + i * 16 + (q % 4) * 4;
+                            c[q] = _mm_add_ps(c[q], _mm_mul_ps(a, _mm_loadu_ps(wq)));
+                        }
+                    }
+                    for (size_t q = 0; q < 8; ++q) _mm_storeu_ps(y + p * 16 + q * 4, c[q]);
+                }
+#endif
+                for (; p < count; ++p)
+                    gemm_panel16<1>(x, k, panels + p * stride, k, y + p * 16);
+            }
+
+        } // namespace simd
+
+    } // namespace algebra
+
+} // namespace utec
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_SIMD_H
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <numeric>
 #include <utility>
+#include "tensor_telemetry.h"
 
 namespace utec
 {
@@ -29,6 +30,7 @@ namespace utec
                     totalSize *= _shape[i];
                 }
                 data.resize(totalSize);
+                telemetry::on_allocate(bytes());
             }
 
             template <typename ... Dims > 
@@ -45,6 +47,45 @@ namespace utec
                     total_size *= shape_[i];
                 }
                 data.resize(total_size);
+                telemetry::on_allocate(bytes());
+            }
+
+            Tensor(const Tensor& other) : shape_(other.shape_), data(other.data) {
+                telemetry::on_copy();
+                telemetry::on_allocate(bytes());
+            }
+
+            Tensor(Tensor&& other) noexcept : shape_(other.shape_), data(std::move(other.data)) {
+                telemetry::on_move();
+            }
+
+            Tensor& operator=(const Tensor& other) {
+                if (this != &other) {
+                    telemetry::on_copy();
+                    const size_t before = bytes();
+                    shape_ = other.shape_;
+                    data = other.data;
+                    if (bytes() != before) {
+                        telemetry::on_release(before);
+                        telemetry::on_allocate(bytes());
+                    }
+                }
+                return *this;
+            }
+
+            Tensor& operator=(Tensor&& other) noexcept {
+                if (this != &other) {
+                    telemetry::on_move();
+                    telemetry::on_release(bytes());
+                    shape_ = other.shape_;
+                    data = std::move(other.data);
+                }
+                return *this;
+            }
+
+            // Memoria reservada por el tensor (capacidad, no solo tamaño).
+            size_t bytes() const noexcept {
+                return data.capacity() * sizeof(T);
             }
             
             void fill(const T& value) {
@@ -99,7 +140,12 @@ namespace utec
                 if (new_total_size < data.size()) {
                     data.resize(new_total_size);
                 } else if (new_total_size > data.size()) {
+                    const size_t before = bytes();
                     data.resize(new_total_size, T{});
+                    if (bytes() != before) {
+                        telemetry::on_release(before);
+                        telemetry::on_allocate(bytes());
+                    }
                 }
             }
             void reshape(const std::array<size_t, Rank>& newShape) {
@@ -388,7 +434,9 @@ namespace utec
             auto cend() const{ 
                 return data.cend();  
             }
-            ~Tensor() {}
+            ~Tensor() {
+                telemetry::on_release(bytes());
+            }
         };
 
 
@@ -494,16 +542,19 @@ namespace utec
                     offset_r += batch_coords[i] * stride_r[i];
                 }
 
+                // Orden i-k-j: la fila de b y la del resultado se recorren de
+                // forma contigua. Cada elemento suma sus k en el mismo orden
+                // que el producto punto, así que el resultado no cambia.
+                const T* pa = a.data.data() + offset_a;
+                const T* pb = b.data.data() + offset_b;
+                T* pr = result.data.data() + offset_r;
                 for (size_t i = 0; i < rows_a; ++i) {
-                    for (size_t j = 0; j < cols_b; ++j) {
-                        T total = T();
-                        for (size_t k = 0; k < common_dim; ++k) {
-                            size_t idx_a = offset_a + i * stride_a[Rank - 2] + k * stride_a[Rank - 1];
-                            size_t idx_b = offset_b + k * stride_b[Rank - 2] + j * stride_b[Rank - 1];
-                            total += a.cbegin()[idx_a] * b.cbegin()[idx_b];
-                        }
-                        size_t idx_r = offset_r + i * stride_r[Rank - 2] + j * stride_r[Rank - 1];
-                        result.begin()[idx_r] = total;
+                    T* r_row = pr + i * stride_r[Rank - 2];
+                    for (size_t k = 0; k < common_dim; ++k) {
+                        const T a_ik = pa[i * stride_a[Rank - 2] + k];
+                        const T* b_row = pb + k * stride_b[Rank - 2];
+                        for (size_t j = 0; j < cols_b; ++j)
+                            r_row[j] += a_ik * b_row[j];
                     }
                 }
             }
@@ -511,6 +562,28 @@ namespace utec
             return result;
         }
 
+        // out += aᵀ · b sin armar la transpuesta (gradiente de los pesos:
+        // entradaᵀ · dZ). Suma las filas en el mismo orden que
+        // matrix_product(transpose_2d(a), b), así que partiendo de cero da
+        // el mismo resultado.
+        template<typename T>
+        void accumulate_transposed_product(Tensor<T, 2>& out, const Tensor<T, 2>& a, const Tensor<T, 2>& b) {
+            const size_t rows = a.shape()[0], m = a.shape()[1], n = b.shape()[1];
+            if (b.shape()[0] != rows || out.shape()[0] != m || out.shape()[1] != n) {
+                throw std::runtime_error("Matrix dimensions are incompatible for multiplication");
+            }
+            for (size_t r = 0; r < rows; ++r) {
+                const T* a_row = a.data.data() + r * m;
+                const T* b_row = b.data.data() + r * n;
+                for (size_t i = 0; i < m; ++i) {
+                    const T a_ri = a_row[i];
+                    T* o_row = out.data.data() + i * n;
+                    for (size_t j = 0; j < n; ++j)
+                        o_row[j] += a_ri * b_row[j];
+                }
+            }
+        }
+
     } // namespace algebra
     
 } // namespace utec
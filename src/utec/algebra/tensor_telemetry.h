@@ -0,0 +1,164 @@
+//
+// Telemetría de memoria de Tensor: reservas, bytes, copias y movimientos.
+//
+// Solo cuenta al compilar con UTEC_TENSOR_TELEMETRY (UTEC_NN_PROFILE la
+// activa también); sin la macro los ganchos quedan vacíos. Los totales son
+// globales y atómicos porque los tensores cruzan hilos (prefetch, evaluate).
+// Para atribuir a un sitio, un Scope apunta los contadores del hilo actual a
+// unas Stats propias, por ejemplo las de una capa en NeuralNetwork.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_TENSOR_TELEMETRY_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_TENSOR_TELEMETRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(UTEC_NN_PROFILE) && !defined(UTEC_TENSOR_TELEMETRY)
+#define UTEC_TENSOR_TELEMETRY
+#endif
+
+namespace utec::algebra::telemetry {
+
+#ifdef UTEC_TENSOR_TELEMETRY
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+// Contadores atribuibles a un sitio.
+struct Stats {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;       // bytes reservados (capacidad)
+    uint64_t copies = 0;
+    uint64_t moves = 0;
+
+    Stats& operator+=(const Stats& o) {
+        allocations += o.allocations;
+        bytes += o.bytes;
+        copies += o.copies;
+        moves += o.moves;
+        return *this;
+    }
+};
+
+struct Totals : Stats {
+    int64_t live_tensors = 0; // tensores que tienen memoria reservada
+    int64_t live_bytes = 0;
+    int64_t peak_bytes = 0;
+};
+
+namespace detail {
+    struct Global {
+        std::atomic<uint64_t> allocations{0}, bytes{0}, copies{0}, moves{0};
+        std::atomic<int64_t> live_tensors{0}, live_bytes{0}, peak_bytes{0};
+    };
+
+    inline Global& global() {
+        static Global g;
+        return g;
+    }
+
+    inline thread_local Stats* site = nullptr;
+    inline thread_local uint64_t thread_allocations = 0;
+}
+
+inline void on_allocate(size_t bytes) {
+#ifdef UTEC_TENSOR_TELEMETRY
+    if (bytes == 0) return;
+    auto& g = detail::global();
+    g.allocations.fetch_add(1, std::memory_order_relaxed);
+    g.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    g.live_tensors.fetch_add(1, std::memory_order_relaxed);
+    const int64_t live = g.live_bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed)
+                       + static_cast<int64_t>(bytes);
+    int64_t peak = g.peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !g.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    ++detail::thread_allocations;
+    if (detail::site) {
+        ++detail::site->allocations;
+        detail::site->bytes += bytes;
+    }
+#else
+    (void)bytes;
+#endif
+}
+
+inline void on_release(size_t bytes) {
+#ifdef UTEC_TENSOR_TELEMETRY
+    if (bytes == 0) return;
+    auto& g = detail::global();
+    g.live_tensors.fetch_sub(1, std::memory_order_relaxed);
+    g.live_bytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+#else
+    (void)bytes;
+#endif
+}
+
+inline void on_copy() {
+#ifdef UTEC_TENSOR_TELEMETRY
+    detail::global().copies.fetch_add(1, std::memory_order_relaxed);
+    if (detail::site) ++detail::site->copies;
+#endif
+}
+
+inline void on_move() {
+#ifdef UTEC_TENSOR_TELEMETRY
+    detail::global().moves.fetch_add(1, std::memory_order_relaxed);
+    if (detail::site) ++detail::site->moves;
+#endif
+}
+
+inline Totals totals() {
+    const auto& g = detail::global();
+    Totals t;
+    t.allocations = g.allocations.load(std::memory_order_relaxed);
+    t.bytes = g.bytes.load(std::memory_order_relaxed);
+    t.copies = g.copies.load(std::memory_order_relaxed);
+    t.moves = g.moves.load(std::memory_order_relaxed);
+    t.live_tensors = g.live_tensors.load(std::memory_order_relaxed);
+    t.live_bytes = g.live_bytes.load(std::memory_order_relaxed);
+    t.peak_bytes = g.peak_bytes.load(std::memory_order_relaxed);
+    return t;
+}
+
+// Pone en cero los acumulados; el pico vuelve a lo que está vivo ahora.
+inline void reset() {
+    auto& g = detail::global();
+    g.allocations = 0;
+    g.bytes = 0;
+    g.copies = 0;
+    g.moves = 0;
+    g.peak_bytes = g.live_bytes.load(std::memory_order_relaxed);
+}
+
+// Reservas hechas por este hilo (para medir un tramo sin interferencias).
+inline uint64_t thread_allocations() {
+    return detail::thread_allocations;
+}
+
+// Mientras vive, lo que haga este hilo se suma también a `target`.
+class Scope {
+private:
+    Stats* previous_;
+
+public:
+    explicit Scope(Stats& target) : previous_(detail::site) { detail::site = &target; }
+    ~Scope() { detail::site = previous_; }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+} // namespace utec::algebra::telemetry
+
+#ifdef UTEC_TENSOR_TELEMETRY
+#define NN_TENSOR_SCOPE_CONCAT_(a, b) a##b
+#define NN_TENSOR_SCOPE_CONCAT(a, b) NN_TENSOR_SCOPE_CONCAT_(a, b)
+#define NN_TENSOR_SCOPE(target) \
+    ::utec::algebra::telemetry::Scope NN_TENSOR_SCOPE_CONCAT(nn_tensor_scope_, __LINE__)(target)
+#else
+#define NN_TENSOR_SCOPE(target) ((void)0)
+#endif
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_TENSOR_TELEMETRY_H
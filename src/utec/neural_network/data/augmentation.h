@@ -0,0 +1,253 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include "prefetch_loader.h"
+
+namespace utec::neural_network {
+
+struct AugmentConfig {
+    size_t width = 28;
+    size_t height = 28;
+    float max_shift = 2.0f;         // pixeles
+    float max_rotation = 10.0f;     // grados
+    float min_scale = 0.9f;
+    float max_scale = 1.1f;
+    float elastic_alpha = 8.0f;     // 0 desactiva la distorsión elástica
+    float elastic_sigma = 4.0f;
+};
+
+// Transformación de una imagen: afín aleatoria (desplazamiento, rotación,
+// escala) más distorsión elástica opcional, muestreada con interpolación
+// bilineal. Todo el estado mutable vive en el Scratch de cada worker.
+template<typename T>
+class Augmenter {
+public:
+    struct Scratch {
+        std::vector<float> padded;       // imagen con borde de ceros (1 antes, 2 después)
+        std::vector<float> sx, sy;       // coordenadas fuente por pixel
+        std::vector<float> dx, dy, tmp, line;  // campos elásticos
+    };
+
+private:
+    AugmentConfig cfg_;
+    std::vector<float> kernel_;
+
+    // Suavizado gaussiano separable con borde replicado; los lazos internos
+    // recorren memoria contigua para que el compilador los vectorice.
+    void smooth(std::vector<float>& field, std::vector<float>& tmp, std::vector<float>& line) const {
+        const size_t w = cfg_.width, h = cfg_.height;
+        const size_t r = kernel_.size() / 2;
+        line.resize(std::max(w, h) + 2 * r);
+        for (size_t y = 0; y < h; ++y) {
+            const float* row = field.data() + y * w;
+            std::fill(line.begin(), line.begin() + r, row[0]);
+            std::copy(row, row + w, line.begin() + r);
+            std::fill(line.begin() + r + w, line.begin() + 2 * r + w, row[w - 1]);
+            float* out = tmp.data() + y * w;
+            std::fill(out, out + w, 0.0f);
+            for (size_t k = 0; k < kernel_.size(); ++k)
+                for (size_t x = 0; x < w; ++x)
+                    out[x] += kernel_[k] * line[x + k];
+        }
+        std::fill(field.begin(), field.end(), 0.0f);
+        for (size_t y = 0; y < h; ++y) {
+            float* out = field.data() + y * w;
+            for (size_t k = 0; k < kernel_.size(); ++k) {
+                const long src_y = std::clamp<long>(static_cast<long>(y + k) - static_cast<long>(r), 0, static_cast<long>(h) - 1);
+                const float* in = tmp.data() + src_y * w;
+                for (size_t x = 0; x < w; ++x)
+                    out[x] += kernel_[k] * in[x];
+            }
+        }
+    }
+
+public:
+    explicit Augmenter(const AugmentConfig& cfg = {}) : cfg_(cfg) {
+        if (cfg_.elastic_alpha > 0.0f) {
+            const int r = std::max(1, static_cast<int>(std::ceil(2.0f * cfg_.elastic_sigma)));
+            float sum = 0.0f;
+            for (int k = -r; k <= r; ++k) {
+                kernel_.push_back(std::exp(-0.5f * k * k / (cfg_.elastic_sigma * cfg_.elastic_sigma)));
+                sum += kernel_.back();
+            }
+            for (auto& v : kernel_) v /= sum;
+        }
+    }
+
+    void apply(const T* src, T* dst, std::mt19937& rng, Scratch& s) const {
+        const size_t w = cfg_.width, h = cfg_.height, n = w * h;
+        const size_t pw = w + 3;
+        s.padded.assign(pw * (h + 3), 0.0f);
+        s.sx.resize(n);
+        s.sy.resize(n);
+        for (size_t y = 0; y < h; ++y)
+            for (size_t x = 0; x < w; ++x)
+                s.padded[(y + 1) * pw + x + 1] = static_cast<float>(src[y * w + x]);
+
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        const float angle = unit(rng) * cfg_.max_rotation * 3.14159265f / 180.0f;
+        const float scale = cfg_.min_scale + (unit(rng) * 0.5f + 0.5f) * (cfg_.max_scale - cfg_.min_scale);
+        const float tx = unit(rng) * cfg_.max_shift, ty = unit(rng) * cfg_.max_shift;
+        const float c = std::cos(angle) / scale, sn = std::sin(angle) / scale;
+        const float cx = (w - 1) * 0.5f, cy = (h - 1) * 0.5f;
+
+        // Mapeo inverso destino -> fuente; lazo plano sin ramas (vectorizable).
+        for (size_t i = 0; i < n; ++i) {
+            const float u = static_cast<float>(i % w) - cx - tx;
+            const float v = static_cast<float>(i / w) - cy - ty;
+            s.sx[i] = c * u + sn * v + cx;
+            s.sy[i] = -sn * u + c * v + cy;
+        }
+
+        if (cfg_.elastic_alpha > 0.0f) {
+            s.dx.resize(n);
+            s.dy.resize(n);
+            s.tmp.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                s.dx[i] = unit(rng);
+                s.dy[i] = unit(rng);
+            }
+            smooth(s.dx, s.tmp, s.line);
+            smooth(s.dy, s.tmp, s.line);
+            for (size_t i = 0; i < n; ++i) {
+                s.sx[i] += cfg_.elastic_alpha * s.dx[i];
+                s.sy[i] += cfg_.elastic_alpha * s.dy[i];
+            }
+        }
+
+        // Bilineal sobre la imagen con borde: las coordenadas se recortan al
+        // anillo de ceros, así que fuera de rango se lee 0 sin ramas. A la
+        // derecha y abajo el recorte cae en la primera columna/fila de ceros
+        // y el vecino +1 es la segunda.
+        const float max_x = static_cast<float>(w + 1), max_y = static_cast<float>(h + 1);
+        for (size_t i = 0; i < n; ++i) {
+            const float px = std::clamp(s.sx[i] + 1.0f, 0.0f, max_x);
+            const float py = std::clamp(s.sy[i] + 1.0f, 0.0f, max_y);
+            const size_t x0 = static_cast<size_t>(px), y0 = static_cast<size_t>(py);
+            const float fx = px - x0, fy = py - y0;
+            const float* row0 = s.padded.data() + y0 * pw + x0;
+            const float* row1 = row0 + pw;
+            const float top = row0[0] + fx * (row0[1] - row0[0]);
+            const float bottom = row1[0] + fx * (row1[1] - row1[0]);
+            dst[i] = static_cast<T>(top + fy * (bottom - top));
+        }
+    }
+
+    size_t image_size() const { return cfg_.width * cfg_.height; }
+};
+
+// Etapa de aumento de datos entre el loader y NeuralNetwork::train. Reparte
+// las filas de cada batch entre `workers` hilos persistentes. Cada worker
+// tiene su propio generador, re-sembrado por (seed, batch, fila): el
+// resultado no depende del número de workers ni del orden de ejecución.
+template<typename T>
+class AugmentationPipeline {
+private:
+    Augmenter<T> augmenter_;
+    uint32_t seed_;
+    uint64_t calls_ = 0;
+
+    struct Worker {
+        std::thread thread;
+        std::mt19937 rng;
+        typename Augmenter<T>::Scratch scratch;
+        std::vector<T> source;
+    };
+    std::vector<Worker> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_ = 0;
+    size_t pending_ = 0;
+    bool stop_ = false;
+
+    T* rows_ = nullptr;
+    size_t count_ = 0;
+    uint64_t call_id_ = 0;
+
+    void process(size_t w) {
+        auto& worker = workers_[w];
+        const size_t image = augmenter_.image_size();
+        const size_t begin = count_ * w / workers_.size();
+        const size_t end = count_ * (w + 1) / workers_.size();
+        worker.source.resize(image);
+        for (size_t r = begin; r < end; ++r) {
+            std::seed_seq seq{seed_, static_cast<uint32_t>(call_id_), static_cast<uint32_t>(call_id_ >> 32),
+                              static_cast<uint32_t>(r)};
+            worker.rng.seed(seq);
+            T* row = rows_ + r * image;
+            std::copy(row, row + image, worker.source.begin());
+            augmenter_.apply(worker.source.data(), row, worker.rng, worker.scratch);
+        }
+    }
+
+    void loop(size_t w) {
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+            }
+            process(w);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--pending_ == 0) done_cv_.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit AugmentationPipeline(const AugmentConfig& cfg = {}, size_t workers = std::thread::hardware_concurrency(),
+                                  uint32_t seed = 42)
+        : augmenter_(cfg), seed_(seed), workers_(std::max<size_t>(workers, 1)) {
+        for (size_t w = 0; w < workers_.size(); ++w)
+            workers_[w].thread = std::thread(&AugmentationPipeline::loop, this, w);
+    }
+
+    AugmentationPipeline(const AugmentationPipeline&) = delete;
+    AugmentationPipeline& operator=(const AugmentationPipeline&) = delete;
+
+    ~AugmentationPipeline() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto& worker : workers_)
+            if (worker.thread.joinable()) worker.thread.join();
+    }
+
+    // Aumenta en el lugar `n` imágenes contiguas de `x`.
+    void operator()(T* x, size_t n) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        rows_ = x;
+        count_ = n;
+        call_id_ = calls_++;
+        pending_ = workers_.size();
+        ++generation_;
+        start_cv_.notify_all();
+        done_cv_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+    // Envuelve una función de gather del PrefetchLoader: el aumento corre en
+    // el hilo de prefetch, fuera del camino crítico del entrenamiento.
+    typename PrefetchLoader<T>::GatherFn wrap(typename PrefetchLoader<T>::GatherFn gather) {
+        return [this, gather = std::move(gather)](const size_t* indices, size_t n, T* x, T* y) {
+            gather(indices, n, x, y);
+            (*this)(x, n);
+        };
+    }
+};
+
+} // namespace utec::neural_network
@@ -7,98 +7,75 @@
 #include <iostream>
 #include <random>
 #include <algorithm>
-#include <numeric> 
+#include <numeric>
+#include <cstdint>
+#include <cmath>
 #include "../../algebra/tensor.h"
+#include "../../algebra/simd.h"
+#include "../nn_random.h"
 
 using namespace std;
 class MNISTLoader {
 private:
-    vector<vector<float>> train_images;
+    static constexpr size_t IMAGE_SIZE = 784;
+
+    // Pixeles crudos (uint8, una fila contigua de 784 por imagen). La
+    // conversión a float normalizado se hace recién al armar el batch.
+    vector<uint8_t> train_pixels;
     vector<int> train_labels;
-    vector<vector<float>> test_images;
+    vector<uint8_t> test_pixels;
     vector<int> test_labels;
 
-    int current_batch_index;
-    mt19937 rng;
+    float train_scale = 1.0f;
+    float test_scale = 1.0f;
+    float mean = 0.0f;
+    float stddev = 1.0f;
+
+    size_t current_batch_index;
+    // Cada barajado usa su propio flujo: el orden de la época k no depende
+    // de cuántos números se sacaron antes.
+    utec::neural_network::rng::Stream shuffle_stream;
+    uint64_t shuffles = 0;
 
 public:
-    MNISTLoader() : current_batch_index(0), rng(42) {}
+    explicit MNISTLoader(uint64_t seed = 42) : current_batch_index(0), shuffle_stream(seed) {}
 
     bool loadTrainData(const string& filename) {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error: No se pudo abrir " << filename << endl;
-            return false;
-        }
-
-        string line;
-        getline(file, line);
-
-        while (getline(file, line)) {
-            if (line.empty()) continue;
-
-            int label = parseLabelFromRow(line);
-            vector<float> image = parseImageRow(line);
-
-            if (image.size() == 784) {
-                train_labels.push_back(label);
-                train_images.push_back(image);
-            }
-        }
-
-        file.close();
+        if (!loadFile(filename, train_pixels, train_labels)) return false;
         normalizeData();
 
-        cout << "Cargados " << train_images.size() << " ejemplos de entrenamiento" << endl;
+        cout << "Cargados " << train_labels.size() << " ejemplos de entrenamiento" << endl;
         return true;
     }
 
     bool loadTestData(const string& filename) {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error: No se pudo abrir " << filename << endl;
-            return false;
-        }
-
-        string line;
-        getline(file, line); 
-
-        while (getline(file, line)) {
-            if (line.empty()) continue;
-
-            int label = parseLabelFromRow(line);
-            vector<float> image = parseImageRow(line);
-
-            if (image.size() == 784) {
-                test_labels.push_back(label);
-                test_images.push_back(image);
-            }
-        }
-
-        file.close();
-        cout << "Cargados " << test_images.size() << " ejemplos de test" << endl;
+        if (!loadFile(filename, test_pixels, test_labels)) return false;
+        cout << "Cargados " << test_labels.size() << " ejemplos de test" << endl;
         return true;
     }
 
     pair<vector<vector<float>>, vector<int>> getTrainData() {
-        return {train_images, train_labels};
+        return {expand(train_pixels, train_scale), train_labels};
     }
 
     pair<vector<vector<float>>, vector<int>> getTestData() {
-        return {test_images, test_labels};
+        return {expand(test_pixels, test_scale), test_labels};
     }
 
     pair<vector<vector<float>>, vector<int>> getBatch(int batch_size) {
         vector<vector<float>> batch_images;
         vector<int> batch_labels;
 
-        for (size_t i = 0; i < static_cast<size_t>(batch_size) && current_batch_index < train_images.size(); i++) {
-            batch_images.push_back(train_images[current_batch_index]);
+        for (size_t i = 0; i < static_cast<size_t>(batch_size) && current_batch_index < train_labels.size(); i++) {
+            vector<float> image(IMAGE_SIZE);
+            utec::algebra::simd::dequantize_u8(&train_pixels[current_batch_index * IMAGE_SIZE], image.data(),
+                                               IMAGE_SIZE, train_scale, 0.0f);
+            batch_images.push_back(move(image));
             batch_labels.push_back(train_labels[current_batch_index]);
             current_batch_index++;
         }
 
-        if (current_batch_index >= train_images.size()) {
+        if (current_batch_index >= train_labels.size()) {
             current_batch_index = 0;
             shuffleTrainData();
         }
@@ -106,42 +83,73 @@ public:
         return {batch_images, batch_labels};
     }
 
+    // Arma un batch a partir de índices: dequantiza, normaliza y (si se
+    // configuró) estandariza en una sola pasada SIMD, y codifica las
+    // etiquetas en one-hot. x: n x 784, y: n x num_classes.
+    void gatherBatch(const size_t* indices, size_t n, float* x, float* y,
+                     bool is_train = true, size_t num_classes = 10) const {
+        const auto& pixels = is_train ? train_pixels : test_pixels;
+        const auto& labels = is_train ? train_labels : test_labels;
+        const float scale = is_train ? train_scale : test_scale;
+        const float a = scale / stddev;
+        const float b = -mean / stddev;
+
+        for (size_t r = 0; r < n; ++r) {
+            utec::algebra::simd::dequantize_u8(&pixels[indices[r] * IMAGE_SIZE], x + r * IMAGE_SIZE, IMAGE_SIZE, a, b);
+            float* y_row = y + r * num_classes;
+            fill(y_row, y_row + num_classes, 0.0f);
+            y_row[labels[indices[r]]] = 1.0f;
+        }
+    }
+
+    // Estandarización opcional (x - mean) / std aplicada en gatherBatch,
+    // sobre los valores ya normalizados.
+    void setStandardization(float m, float s) {
+        mean = m;
+        stddev = s;
+    }
+
+    pair<float, float> computeTrainStatistics() const {
+        double sum = 0.0, sq = 0.0;
+        for (uint8_t p : train_pixels) {
+            double v = p * static_cast<double>(train_scale);
+            sum += v;
+            sq += v * v;
+        }
+        const double n = max<size_t>(train_pixels.size(), 1);
+        const double m = sum / n;
+        return {static_cast<float>(m), static_cast<float>(sqrt(max(sq / n - m * m, 1e-12)))};
+    }
+
     void shuffleTrainData() {
-        vector<int> indices(train_images.size());
+        vector<size_t> indices(train_labels.size());
         iota(indices.begin(), indices.end(), 0);
-        shuffle(indices.begin(), indices.end(), rng);
+        utec::neural_network::rng::shuffle(indices.begin(), indices.end(), shuffle_stream.split(shuffles++));
 
-        vector<vector<float>> shuffled_images;
-        vector<int> shuffled_labels;
+        vector<uint8_t> shuffled_pixels(train_pixels.size());
+        vector<int> shuffled_labels(train_labels.size());
 
-        for (int idx : indices) {
-            shuffled_images.push_back(train_images[idx]);
-            shuffled_labels.push_back(train_labels[idx]);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            copy_n(&train_pixels[indices[i] * IMAGE_SIZE], IMAGE_SIZE, &shuffled_pixels[i * IMAGE_SIZE]);
+            shuffled_labels[i] = train_labels[indices[i]];
         }
 
-        train_images = shuffled_images;
-        train_labels = shuffled_labels;
+        train_pixels.swap(shuffled_pixels);
+        train_labels.swap(shuffled_labels);
     }
 
+    // Los pixeles se guardan crudos; normalizar solo fija la escala con la
+    // que se convierten a float (mismo efecto que dividir entre 255).
     void normalizeData() {
-        for (auto& image : train_images) {
-            for (float& pixel : image) {
-                pixel /= 255.0f;
-            }
-        }
-
-        for (auto& image : test_images) {
-            for (float& pixel : image) {
-                pixel /= 255.0f;
-            }
-        }
+        if (!train_pixels.empty()) train_scale = 1.0f / 255.0f;
+        if (!test_pixels.empty()) test_scale = 1.0f / 255.0f;
     }
 
     void printSample(int index, bool is_train = true) {
-        const auto& images = is_train ? train_images : test_images;
+        const auto& pixels = is_train ? train_pixels : test_pixels;
         const auto& labels = is_train ? train_labels : test_labels;
 
-        if (index >= static_cast<int>(images.size())) {
+        if (index >= static_cast<int>(labels.size())) {
             cout << "Indice fuera de rango" << endl;
             return;
         }
@@ -151,7 +159,7 @@ public:
 
         for (size_t i = 0; i < 28; i++) {
             for (size_t j = 0; j < 28; j++) {
-                float pixel = images[index][i * 28 + j];
+                float pixel = pixels[index * IMAGE_SIZE + i * 28 + j] / 255.0f;
                 if (pixel > 0.5) cout << "##";
                 else if (pixel > 0.25) cout << "..";
                 else cout << "  ";
@@ -162,16 +170,52 @@ public:
 
     void printDatasetInfo() {
         cout << "  MNIST Dataset Info" << endl;
-        cout << "Entrenamiento: " << train_images.size() << " imagenes" << endl;
-        cout << "Test: " << test_images.size() << " imagenes" << endl;
+        cout << "Entrenamiento: " << train_labels.size() << " imagenes" << endl;
+        cout << "Test: " << test_labels.size() << " imagenes" << endl;
         cout << "Dimension de imagen: 784 (28x28)" << endl;
         cout << "Clases: 0-9 (10 dígitos)" << endl;
+        cout << "Memoria de pixeles: " << memoryBytes() / (1024.0 * 1024.0) << " MB" << endl;
     }
 
-    int getTrainSize() const { return train_images.size(); }
-    int getTestSize() const { return test_images.size(); }
+    int getTrainSize() const { return train_labels.size(); }
+    int getTestSize() const { return test_labels.size(); }
+
+    size_t memoryBytes() const {
+        return train_pixels.capacity() + test_pixels.capacity()
+             + (train_labels.capacity() + test_labels.capacity()) * sizeof(int);
+    }
 
 private:
+    bool loadFile(const string& filename, vector<uint8_t>& pixels, vector<int>& labels) {
+        ifstream file(filename);
+        if (!file.is_open()) {
+            cerr << "Error: No se pudo abrir " << filename << endl;
+            return false;
+        }
+
+        string line;
+        getline(file, line);
+
+        while (getline(file, line)) {
+            if (line.empty()) continue;
+
+            int label = parseLabelFromRow(line);
+            if (parseImageRow(line, pixels)) {
+                labels.push_back(label);
+            }
+        }
+
+        file.close();
+        return true;
+    }
+
+    static vector<vector<float>> expand(const vector<uint8_t>& pixels, float scale) {
+        vector<vector<float>> images(pixels.size() / IMAGE_SIZE, vector<float>(IMAGE_SIZE));
+        for (size_t i = 0; i < images.size(); ++i)
+            utec::algebra::simd::dequantize_u8(&pixels[i * IMAGE_SIZE], images[i].data(), IMAGE_SIZE, scale, 0.0f);
+        return images;
+    }
+
     vector<string> split(const string& str, char delimiter) {
         vector<string> tokens;
         stringstream ss(str);
@@ -184,15 +228,17 @@ private:
         return tokens;
     }
 
-    vector<float> parseImageRow(const string& row) {
+    // Agrega la fila a `pixels` solo si trae exactamente 784 valores.
+    bool parseImageRow(const string& row, vector<uint8_t>& pixels) {
         vector<string> tokens = split(row, ',');
-        vector<float> image;
+        if (tokens.size() != IMAGE_SIZE + 1) return false;
 
         for (size_t i = 1; i < tokens.size(); i++) {
-            image.push_back(stof(tokens[i]));
+            float value = stof(tokens[i]);
+            pixels.push_back(static_cast<uint8_t>(min(max(value, 0.0f), 255.0f)));
         }
 
-        return image;
+        return true;
     }
 
     int parseLabelFromRow(const string& row) {
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "prefetch_loader.h"
+
+namespace utec::neural_network {
+
+// Dataset en streaming para CSV tipo MNIST (label,p0,...,p783) más grandes
+// que la RAM. Lee el archivo por bloques de `chunk_bytes`, guarda los pixeles
+// como uint8 en un buffer de mezcla acotado (aleatorización aproximada) y
+// arma batches en un Batch preasignado. La memoria total es fija:
+// bloque + buffer de mezcla + un batch (ver memory_ceiling()).
+template<typename T>
+class MNISTStream {
+public:
+    struct Stats {
+        size_t bytes_read = 0;
+        size_t samples = 0;
+        double seconds = 0.0;
+
+        double mb_per_s() const { return seconds > 0 ? bytes_read / (1024.0 * 1024.0) / seconds : 0.0; }
+        double samples_per_s() const { return seconds > 0 ? samples / seconds : 0.0; }
+    };
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    std::ifstream file_;
+    size_t image_size_;
+    size_t num_classes_;
+    T scale_;
+
+    std::vector<char> chunk_;
+    size_t pos_ = 0;
+    size_t len_ = 0;
+    bool eof_ = false;
+
+    std::vector<uint8_t> pool_;
+    std::vector<int> pool_labels_;
+    size_t capacity_;
+    size_t fill_ = 0;
+    std::mt19937 rng_;
+
+    size_t skip_ = 0;        // filas válidas que se saltan al inicio de cada época
+    size_t skipped_ = 0;
+    size_t limit_ = 0;       // filas por época (0: todo el archivo)
+    size_t rows_read_ = 0;
+
+    size_t batch_size_;
+    Batch<T> batch_;
+    uint64_t next_id_ = 0;
+    Stats stats_;
+
+    void rewind() {
+        file_.clear();
+        file_.seekg(0);
+        pos_ = len_ = 0;
+        eof_ = false;
+        skipped_ = 0;
+        rows_read_ = 0;
+    }
+
+    // Deja en [pos_, nl) una línea completa; false si no quedan líneas.
+    bool next_line(size_t& nl) {
+        while (true) {
+            const char* begin = chunk_.data() + pos_;
+            const char* found = static_cast<const char*>(std::memchr(begin, '\n', len_ - pos_));
+            if (found) {
+                nl = static_cast<size_t>(found - chunk_.data());
+                return true;
+            }
+            if (!file_) {
+                if (pos_ == len_) return false;
+                nl = len_;  // última línea sin '\n'
+                return true;
+            }
+
+            std::memmove(chunk_.data(), begin, len_ - pos_);
+            len_ -= pos_;
+            pos_ = 0;
+            if (len_ == chunk_.size())
+                chunk_.resize(chunk_.size() * 2);  // línea más larga que el bloque
+
+            file_.read(chunk_.data() + len_, static_cast<std::streamsize>(chunk_.size() - len_));
+            const size_t got = static_cast<size_t>(file_.gcount());
+            len_ += got;
+            stats_.bytes_read += got;
+        }
+    }
+
+    // Parsea la próxima fila válida directamente en el slot `slot` del pool.
+    bool read_row(size_t slot) {
+        size_t nl;
+        while (!eof_ && (limit_ == 0 || rows_read_ < limit_) && next_line(nl)) {
+            const char* p = chunk_.data() + pos_;
+            const char* end = chunk_.data() + nl;
+            pos_ = nl < len_ ? nl + 1 : nl;
+
+            if (p == end || *p < '0' || *p > '9') continue;  // cabecera o línea vacía
+
+            uint8_t* pixels = pool_.data() + slot * image_size_;
+            size_t field = 0;
+            int value = 0;
+            int label = 0;
+            for (; p <= end; ++p) {
+                if (p == end || *p == ',') {
+                    if (field == 0) label = value;
+                    else if (field <= image_size_) pixels[field - 1] = static_cast<uint8_t>(std::min(value, 255));
+                    ++field;
+                    value = 0;
+                } else if (*p >= '0' && *p <= '9') {
+                    value = value * 10 + (*p - '0');
+                }
+            }
+            if (field != image_size_ + 1 || label < 0 || label >= static_cast<int>(num_classes_))
+                continue;
+            if (skipped_ < skip_) {
+                ++skipped_;
+                continue;
+            }
+
+            pool_labels_[slot] = label;
+            ++rows_read_;
+            return true;
+        }
+        eof_ = true;
+        return false;
+    }
+
+    // Emite un sample elegido al azar del buffer de mezcla y lo repone con
+    // la siguiente fila del archivo.
+    bool emit(T* x_row, T* y_row) {
+        while (fill_ < capacity_ && read_row(fill_))
+            ++fill_;
+        if (fill_ == 0) return false;
+
+        const size_t j = std::uniform_int_distribution<size_t>(0, fill_ - 1)(rng_);
+        const uint8_t* pixels = pool_.data() + j * image_size_;
+        for (size_t k = 0; k < image_size_; ++k)
+            x_row[k] = static_cast<T>(pixels[k]) * scale_;
+        std::fill(y_row, y_row + num_classes_, T(0));
+        y_row[pool_labels_[j]] = T(1);
+
+        if (!read_row(j)) {
+            --fill_;
+            std::memmove(pool_.data() + j * image_size_, pool_.data() + fill_ * image_size_, image_size_);
+            pool_labels_[j] = pool_labels_[fill_];
+        }
+        return true;
+    }
+
+public:
+    MNISTStream(const std::string& path, size_t batch_size, size_t shuffle_buffer = 4096,
+                size_t chunk_bytes = 1 << 20, uint32_t seed = 42,
+                size_t image_size = 784, size_t num_classes = 10, T scale = T(1) / T(255))
+        : file_(path, std::ios::binary), image_size_(image_size), num_classes_(num_classes),
+          scale_(scale), chunk_(std::max<size_t>(chunk_bytes, 64)),
+          pool_(std::max<size_t>(shuffle_buffer, 1) * image_size), pool_labels_(std::max<size_t>(shuffle_buffer, 1)),
+          capacity_(std::max<size_t>(shuffle_buffer, 1)), rng_(seed),
+          batch_size_(batch_size), batch_(batch_size, image_size, num_classes) {
+        if (!file_.is_open()) {
+            throw std::runtime_error("MNISTStream: cannot open " + path);
+        }
+        if (batch_size == 0) {
+            throw std::runtime_error("MNISTStream: batch_size must be positive");
+        }
+    }
+
+    // Mismo protocolo que PrefetchLoader: batch válido hasta la próxima
+    // llamada, o nullptr al terminar la época (el archivo se rebobina).
+    const Batch<T>* next() {
+        auto t0 = clock::now();
+        batch_.resize(batch_size_);
+
+        size_t n = 0;
+        while (n < batch_size_ && emit(batch_.x.data.data() + n * image_size_, batch_.y.data.data() + n * num_classes_))
+            ++n;
+
+        stats_.samples += n;
+        if (n == 0) {
+            rewind();
+            stats_.seconds += std::chrono::duration<double>(clock::now() - t0).count();
+            return nullptr;
+        }
+        batch_.resize(n);
+        batch_.id = next_id_++;
+        stats_.seconds += std::chrono::duration<double>(clock::now() - t0).count();
+        return &batch_;
+    }
+
+    // Usa solo las primeras `rows` filas válidas de cada época (p. ej. para
+    // dejar las últimas como validación).
+    void limit_rows(size_t rows) { limit_ = rows; }
+
+    // Se salta las primeras `rows` filas válidas de cada época; limit_rows
+    // cuenta a partir de ahí.
+    void skip_rows(size_t rows) { skip_ = rows; }
+
+    // Filas válidas del archivo (las que da una época sin límite), leídas por
+    // bloques: no guarda más que un bloque y una fila.
+    static size_t count_rows(const std::string& path, size_t image_size = 784, size_t num_classes = 10) {
+        MNISTStream counter(path, 1, 1, 1 << 20, 0, image_size, num_classes);
+        size_t rows = 0;
+        while (counter.read_row(0)) ++rows;
+        return rows;
+    }
+
+    // Copia en orden las filas válidas [first, first + X.shape()[0]) a X / Y
+    // sin cargar el resto del archivo (p. ej. la validación del final del
+    // CSV de entrenamiento).
+    static void read_rows(const std::string& path, size_t first, algebra::Tensor<T, 2>& X, algebra::Tensor<T, 2>& Y,
+                          T scale = T(1) / T(255)) {
+        const size_t rows = X.shape()[0], image_size = X.shape()[1], num_classes = Y.shape()[1];
+        MNISTStream stream(path, std::max<size_t>(std::min<size_t>(rows, 512), 1), 1, 1 << 20, 0,
+                           image_size, num_classes, scale);
+        stream.skip_rows(first);
+        stream.limit_rows(rows);
+        size_t copied = 0;
+        while (rows > 0) {
+            const Batch<T>* batch = stream.next();
+            if (!batch) break;
+            std::copy_n(batch->x.data.data(), batch->size * image_size, X.data.data() + copied * image_size);
+            std::copy_n(batch->y.data.data(), batch->size * num_classes, Y.data.data() + copied * num_classes);
+            copied += batch->size;
+        }
+        if (copied != rows) {
+            throw std::runtime_error("MNISTStream: " + path + " has fewer than " + std::to_string(first + rows) + " rows");
+        }
+    }
+
+    const Stats& stats() const { return stats_; }
+
+    size_t memory_ceiling() const {
+        return chunk_.capacity() + pool_.capacity() + pool_labels_.capacity() * sizeof(int)
+             + (batch_.x.data.capacity() + batch_.y.data.capacity()) * sizeof(T);
+    }
+};
+
+} // namespace utec::neural_network
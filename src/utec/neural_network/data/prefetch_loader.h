@@ -0,0 +1,257 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include "../../algebra/tensor.h"
+
+namespace utec::neural_network {
+
+// Batch preasignado: x/y se reservan con batch_size filas y solo se
+// redimensionan (sin realocar) cuando el último batch de la época es menor.
+template<typename T>
+struct Batch {
+    algebra::Tensor<T, 2> x;
+    algebra::Tensor<T, 2> y;
+    size_t size = 0;
+    uint64_t id = 0;
+    uint64_t epoch = 0;   // época del loader a la que pertenece
+    size_t index = 0;     // posición del batch dentro de la época
+    bool end_of_epoch = false;
+
+    Batch(size_t rows, size_t x_cols, size_t y_cols) : x(rows, x_cols), y(rows, y_cols) {}
+
+    void resize(size_t rows) {
+        size = rows;
+        x.reshape(rows, x.shape()[1]);
+        y.reshape(rows, y.shape()[1]);
+    }
+};
+
+// Copia las filas `indices` de un dataset en memoria a los buffers del batch,
+// escalando los pixeles y codificando las etiquetas en one-hot.
+template<typename T>
+std::function<void(const size_t*, size_t, T*, T*)> make_gather(
+    const std::vector<std::vector<float>>& images,
+    const std::vector<int>& labels,
+    size_t num_classes,
+    T scale = T(1)) {
+    return [&images, &labels, num_classes, scale](const size_t* indices, size_t n, T* x, T* y) {
+        const size_t cols = images.empty() ? 0 : images[0].size();
+        for (size_t r = 0; r < n; ++r) {
+            const auto& image = images[indices[r]];
+            T* x_row = x + r * cols;
+            for (size_t k = 0; k < cols; ++k)
+                x_row[k] = static_cast<T>(image[k]) * scale;
+
+            T* y_row = y + r * num_classes;
+            std::fill(y_row, y_row + num_classes, T(0));
+            y_row[labels[indices[r]]] = T(1);
+        }
+    };
+}
+
+// Loader con prefetch: un hilo de fondo arma el batch N+1 mientras la red
+// procesa el batch N. Los batches viven en un anillo acotado de `depth`
+// buffers preasignados (depth = 2 es doble buffer).
+template<typename T>
+class PrefetchLoader {
+public:
+    using GatherFn = std::function<void(const size_t*, size_t, T*, T*)>;
+
+    struct Stats {
+        size_t batches = 0;
+        double consumer_wait = 0.0;  // segundos que el entrenamiento esperó datos
+        double producer_wait = 0.0;  // segundos que el productor esperó un buffer libre
+        double produce_time = 0.0;   // segundos armando batches
+    };
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    size_t samples_;
+    size_t batch_size_;
+    GatherFn gather_;
+    bool shuffle_;
+    std::mt19937 rng_;
+    std::vector<size_t> order_;
+
+    std::vector<Batch<T>> ring_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    bool holding_ = false;
+    bool stop_ = false;
+
+    // Estado del RNG al inicio de cada época aún en el anillo, y posición
+    // del último batch entregado: con eso se puede reanudar exactamente.
+    size_t first_batch_ = 0;
+    std::map<uint64_t, std::string> epoch_rng_;
+    uint64_t last_epoch_ = 0;
+    size_t last_index_ = 0;
+
+    Stats stats_;
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::thread worker_;
+
+    void produce() {
+        uint64_t next_id = 0;
+        for (uint64_t epoch = 0; ; ++epoch) {
+            {
+                std::ostringstream state;
+                state << rng_;
+                std::lock_guard<std::mutex> lock(mutex_);
+                epoch_rng_[epoch] = state.str();
+            }
+            // El orden de cada época depende solo del estado del RNG al inicio.
+            if (shuffle_) {
+                std::iota(order_.begin(), order_.end(), size_t(0));
+                std::shuffle(order_.begin(), order_.end(), rng_);
+            }
+
+            const size_t batches = batches_per_epoch();
+            for (size_t b = epoch == 0 ? first_batch_ : 0; b <= batches; ++b) {
+                const size_t start = b * batch_size_;
+                const bool last = b == batches;
+                size_t slot;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    auto t0 = clock::now();
+                    not_full_.wait(lock, [this] { return stop_ || count_ < ring_.size(); });
+                    stats_.producer_wait += std::chrono::duration<double>(clock::now() - t0).count();
+                    if (stop_) return;
+                    slot = (head_ + count_) % ring_.size();
+                }
+
+                auto& batch = ring_[slot];
+                auto t0 = clock::now();
+                batch.end_of_epoch = last;
+                batch.epoch = epoch;
+                batch.index = b;
+                if (!last) {
+                    batch.resize(std::min(batch_size_, samples_ - start));
+                    batch.id = next_id++;
+                    gather_(order_.data() + start, batch.size, batch.x.data.data(), batch.y.data.data());
+                }
+                auto elapsed = std::chrono::duration<double>(clock::now() - t0).count();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stats_.produce_time += elapsed;
+                    ++count_;
+                }
+                not_empty_.notify_one();
+            }
+        }
+    }
+
+    void release_held() {
+        if (!holding_) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            head_ = (head_ + 1) % ring_.size();
+            --count_;
+            holding_ = false;
+        }
+        not_full_.notify_one();
+    }
+
+public:
+    // `resume_from` es un valor devuelto por save_position() (p. ej. guardado
+    // en un checkpoint); vacío empieza desde el principio.
+    PrefetchLoader(size_t samples, size_t x_cols, size_t y_cols, size_t batch_size, GatherFn gather,
+                   size_t depth = 2, bool shuffle = true, uint32_t seed = 42,
+                   const std::string& resume_from = "")
+        : samples_(samples), batch_size_(batch_size), gather_(std::move(gather)),
+          shuffle_(shuffle), rng_(seed), order_(samples) {
+        if (batch_size_ == 0 || depth == 0) {
+            throw std::runtime_error("PrefetchLoader: batch_size and depth must be positive");
+        }
+        std::iota(order_.begin(), order_.end(), size_t(0));
+        if (!resume_from.empty()) {
+            std::istringstream in(resume_from);
+            in >> first_batch_ >> rng_;
+            if (!in) {
+                throw std::runtime_error("PrefetchLoader: invalid resume position");
+            }
+            // first_batch_ == batches: solo falta entregar el fin de época.
+            // Mayor: el fin de época ya se entregó, se salta a la siguiente.
+            if (first_batch_ > batches_per_epoch()) {
+                if (shuffle_)
+                    std::shuffle(order_.begin(), order_.end(), rng_);
+                first_batch_ = 0;
+            }
+        }
+        ring_.reserve(depth);
+        for (size_t i = 0; i < depth; ++i)
+            ring_.emplace_back(batch_size_, x_cols, y_cols);
+        worker_ = std::thread(&PrefetchLoader::produce, this);
+    }
+
+    PrefetchLoader(const PrefetchLoader&) = delete;
+    PrefetchLoader& operator=(const PrefetchLoader&) = delete;
+
+    ~PrefetchLoader() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        not_full_.notify_all();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    // Devuelve el siguiente batch (válido hasta la próxima llamada) o nullptr
+    // al terminar la época; la llamada siguiente empieza la época nueva.
+    const Batch<T>* next() {
+        release_held();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto t0 = clock::now();
+        not_empty_.wait(lock, [this] { return count_ > 0; });
+        stats_.consumer_wait += std::chrono::duration<double>(clock::now() - t0).count();
+
+        auto& batch = ring_[head_];
+        holding_ = true;
+        last_epoch_ = batch.epoch;
+        last_index_ = batch.index;
+        epoch_rng_.erase(epoch_rng_.begin(), epoch_rng_.lower_bound(batch.epoch));
+        if (batch.end_of_epoch) {
+            lock.unlock();
+            release_held();
+            return nullptr;
+        }
+        ++stats_.batches;
+        return &batch;
+    }
+
+    // Posición justo después del último batch entregado por next().
+    std::string save_position() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = epoch_rng_.find(last_epoch_);
+        if (it == epoch_rng_.end()) return "";
+        return std::to_string(last_index_ + 1) + " " + it->second;
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    size_t batches_per_epoch() const {
+        return (samples_ + batch_size_ - 1) / batch_size_;
+    }
+};
+
+} // namespace utec::neural_network
@@ -0,0 +1,173 @@
+//
+// Archivo mapeado en memoria de solo lectura (mmap / MapViewOfFile).
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_MAPPED_FILE_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_MAPPED_FILE_H
+
+#include <string>
+#include <stdexcept>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <filesystem>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace utec::neural_network {
+
+class MappedFile {
+private:
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        LARGE_INTEGER size;
+        GetFileSizeEx(file_, &size);
+        size_ = static_cast<size_t>(size.QuadPart);
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) {
+            CloseHandle(file_);
+            throw std::runtime_error("Cannot map " + path);
+        }
+        data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (!data_) {
+            CloseHandle(mapping_);
+            CloseHandle(file_);
+            throw std::runtime_error("Cannot map " + path);
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map empty file " + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        // MAP_SHARED de solo lectura: todos los procesos que mapean el mismo
+        // archivo comparten las páginas físicas del page cache.
+        void* ptr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (ptr == MAP_FAILED) {
+            throw std::runtime_error("Cannot map " + path);
+        }
+        data_ = static_cast<const unsigned char*>(ptr);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+        if (data_) ::munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+    }
+
+    const unsigned char* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+};
+
+// Registro de mapeos del proceso: abrir varias veces el mismo archivo reusa
+// un único mapeo mientras alguna instancia lo tenga. Entre procesos no hace
+// falta registro: MAP_SHARED ya comparte las páginas del page cache.
+class SharedMappings {
+public:
+    struct Handle {
+        std::shared_ptr<const MappedFile> file;
+        bool verified;
+        std::string key;
+    };
+
+    static Handle acquire(const std::string& path) {
+        const std::string key = key_of(path);
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (auto it = r.entries.begin(); it != r.entries.end();) {
+            if (it->second.file.expired()) it = r.entries.erase(it);
+            else ++it;
+        }
+        Entry& entry = r.entries[key];
+        if (auto file = entry.file.lock()) return {file, entry.verified, key};
+        auto file = std::make_shared<const MappedFile>(path);
+        entry = {file, false};
+        return {file, false, key};
+    }
+
+    // Los checksums de un mapeo se validan una sola vez.
+    static void mark_verified(const Handle& handle) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto it = r.entries.find(handle.key);
+        if (it != r.entries.end() && it->second.file.lock() == handle.file) it->second.verified = true;
+    }
+
+    static size_t active() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        size_t count = 0;
+        for (const auto& [key, entry] : r.entries) count += !entry.file.expired();
+        return count;
+    }
+
+private:
+    struct Entry {
+        std::weak_ptr<const MappedFile> file;
+        bool verified = false;
+    };
+    struct Registry {
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    static Registry& registry() {
+        static Registry r;
+        return r;
+    }
+
+    // Ruta canónica más tamaño y fecha: si el archivo se reemplaza, se mapea de nuevo.
+    static std::string key_of(const std::string& path) {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        const fs::path canonical = fs::weakly_canonical(path, ec);
+        const auto size = fs::file_size(path, ec);
+        const auto time = fs::last_write_time(path, ec).time_since_epoch().count();
+        return (ec ? path : canonical.string()) + "|" + std::to_string(size) + "|" + std::to_string(time);
+    }
+};
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_MAPPED_FILE_H
@@ -10,11 +10,30 @@
 #include "nn_loss.h"
 #include "nn_dense.h"
 #include "nn_activation.h"
+#include "nn_model_file.h"
+#include "nn_checkpoint.h"
+#include "nn_sparse_dense.h"
+#include "nn_conv.h"
+#include "nn_batchnorm.h"
+#include "nn_random.h"
+#include "nn_pruning.h"
+#include "nn_inference_plan.h"
+#include "nn_profiler.h"
+#include "nn_training.h"
+#include "nn_schedule.h"
 #include <vector>
 #include <memory>
 #include <cassert>
 #include <fstream>
 #include <string>
+#include <algorithm>
+#include <sstream>
+#include <type_traits>
+#include <filesystem>
+#include <map>
+#include <chrono>
+#include <optional>
+#include <cmath>
 
 namespace utec {
 namespace neural_network {
@@ -24,11 +43,382 @@ class NeuralNetwork {
 private:
     std::vector<std::unique_ptr<ILayer<T>>> layers;
 
+    // El optimizador vive entre batches y épocas (Adam necesita sus momentos).
+    std::unique_ptr<IOptimizer<T>> optimizer_;
+    std::string pending_optimizer_state_;
+
+    TrainingState state_;
+    std::unique_ptr<AsyncCheckpointWriter<T>> checkpoint_writer_;
+    size_t checkpoint_every_ = 0;
+
+    // Checkpointing de activaciones: capas por segmento (0 = ⌈√capas⌉).
+    bool recompute_ = false;
+    size_t segment_layers_ = 0;
+
+    std::unique_ptr<GradualPruner<T>> pruner_;
+
+    std::shared_ptr<const LRSchedule<T>> schedule_;
+    T current_rate_ = T(0);
+
+    // Pesos preempaquetados para predict; cualquier cambio de capas o de
+    // pesos lo descarta.
+    std::unique_ptr<InferencePlan<T>> plan_;
+
+    // Reservas, copias y movimientos de Tensor por capa y fase (solo con
+    // UTEC_TENSOR_TELEMETRY; ver tensor_telemetry.h).
+    std::map<std::string, algebra::telemetry::Stats> tensor_stats_;
+
+    // Seguimiento por época (ver nn_training.h).
+    double epoch_loss_sum_ = 0.0;
+    size_t epoch_samples_ = 0;
+    std::chrono::steady_clock::time_point epoch_start_;
+    const algebra::Tensor<T, 2>* validation_x_ = nullptr;
+    const algebra::Tensor<T, 2>* validation_y_ = nullptr;
+    size_t validate_every_ = 1;
+    std::optional<EarlyStopping> early_stopping_;
+    std::vector<algebra::Tensor<T, 2>> best_params_;
+    EpochCallback<T> epoch_callback_;
+    std::vector<EpochStats<T>> history_;
+    bool stopped_ = false;
+
+    algebra::telemetry::Stats& tensor_site(const std::string& name, profiler::Phase phase) {
+        return tensor_stats_[name + " " + profiler::phase_name(phase)];
+    }
+
+    // Con un programa de tasa, `learning_rate` es la base y la tasa efectiva
+    // depende del paso.
+    template<template <typename...> class OptimizerType>
+    IOptimizer<T>& optimizer(T learning_rate) {
+        if (schedule_) learning_rate = schedule_->rate(state_.step, learning_rate);
+        current_rate_ = learning_rate;
+        if (!dynamic_cast<OptimizerType<T>*>(optimizer_.get())) {
+            optimizer_ = std::make_unique<OptimizerType<T>>(learning_rate);
+            if (!pending_optimizer_state_.empty()) {
+                std::istringstream in(pending_optimizer_state_, std::ios::binary);
+                optimizer_->load_state(in);
+                pending_optimizer_state_.clear();
+            }
+        }
+        optimizer_->set_learning_rate(learning_rate);
+        return *optimizer_;
+    }
+
+    template<typename L, typename = void>
+    struct has_save_position : std::false_type {};
+    template<typename L>
+    struct has_save_position<L, std::void_t<decltype(std::declval<const L&>().save_position())>> : std::true_type {};
+
+    template<typename Loader>
+    void after_step(const Loader* loader) {
+        ++state_.batch;
+        if (pruner_) pruner_->on_step(layers, state_.step);
+        if (checkpoint_every_ == 0 || state_.step % checkpoint_every_ != 0) return;
+        if constexpr (!std::is_same_v<Loader, void>) {
+            if constexpr (has_save_position<Loader>::value)
+                state_.loader_state = loader->save_position();
+        }
+        checkpoint_now();
+    }
+
+    // Nombre y costo estimado (FLOPs, bytes leídos + escritos) de una capa
+    // para el profiler. `width` es el ancho del tensor que recibe la fase:
+    // la entrada en forward, el gradiente en backward.
+    static std::string layer_label(const ILayer<T>& layer, size_t index) {
+        std::string name = std::to_string(index) + ":";
+        if (auto dense = dynamic_cast<const Dense<T>*>(&layer))
+            return name + "Dense " + std::to_string(dense->in_features()) + "x" + std::to_string(dense->out_features());
+        if (auto sparse = dynamic_cast<const SparseDense<T>*>(&layer))
+            return name + "SparseDense " + std::to_string(sparse->in_features()) + "x" + std::to_string(sparse->out_features());
+        if (auto conv = dynamic_cast<const Conv2D<T>*>(&layer))
+            return name + "Conv2D " + std::to_string(conv->in_channels()) + "->" + std::to_string(conv->out_channels())
+                 + " k" + std::to_string(conv->kernel());
+        if (auto bn = dynamic_cast<const BatchNorm<T>*>(&layer)) return name + "BatchNorm " + std::to_string(bn->features());
+        if (dynamic_cast<const Dropout<T>*>(&layer)) return name + "Dropout";
+        if (dynamic_cast<const MaxPool2D<T>*>(&layer)) return name + "MaxPool2D";
+        if (dynamic_cast<const AvgPool2D<T>*>(&layer)) return name + "AvgPool2D";
+        if (dynamic_cast<const ReLU<T>*>(&layer)) return name + "ReLU";
+        if (dynamic_cast<const Sigmoid<T>*>(&layer)) return name + "Sigmoid";
+        return name + "Layer";
+    }
+
+    static std::pair<uint64_t, uint64_t> layer_cost(ILayer<T>& layer, profiler::Phase phase, size_t rows, size_t width) {
+        using profiler::Phase;
+        const uint64_t r = rows, s = sizeof(T);
+        if (phase == Phase::Update) {
+            uint64_t params = 0;
+            for (auto* p : layer.parameters()) params += p->size();
+            return {2 * params, 3 * params * s};
+        }
+        const bool forward = phase == Phase::Forward || phase == Phase::Predict;
+        if (auto dense = dynamic_cast<const Dense<T>*>(&layer)) {
+            const uint64_t i = dense->in_features(), o = dense->out_features();
+            if (forward) return {2 * r * i * o, (r * i + i * o + o + r * o) * s};
+            return {4 * r * i * o + r * o, (r * o + 2 * r * i + 2 * i * o + o) * s};
+        }
+        if (auto sparse = dynamic_cast<const SparseDense<T>*>(&layer)) {
+            const uint64_t i = sparse->in_features(), o = sparse->out_features(), nnz = sparse->nnz();
+            if (forward) return {2 * r * nnz, (r * i + r * o) * s + nnz * (s + 4)};
+            return {4 * r * nnz + r * o, (r * o + 2 * r * i) * s + nnz * (2 * s + 4)};
+        }
+        if (auto conv = dynamic_cast<const Conv2D<T>*>(&layer)) {
+            // im2col + matrix_product: la matriz de columnas se escribe y se lee.
+            const uint64_t macs = conv->macs(), i = conv->input_size(), o = conv->output_size();
+            const uint64_t cols = r * conv->out_height() * conv->out_width() * conv->kernel() * conv->kernel() * conv->in_channels();
+            if (forward) return {2 * r * macs, (r * i + 2 * cols + r * o) * s};
+            return {4 * r * macs + r * o, (r * o + 4 * cols + r * i) * s};
+        }
+        // Elemento a elemento (activaciones, pooling).
+        return {r * width, (forward ? 2 : 3) * r * width * s};
+    }
+
+    // Parámetros y después buffers de todas las capas: lo que guardan los
+    // checkpoints y la parada temprana.
+    std::vector<algebra::Tensor<T, 2>*> state_tensors() {
+        std::vector<algebra::Tensor<T, 2>*> tensors;
+        for (auto& layer : layers)
+            for (auto* param : layer->parameters()) tensors.push_back(param);
+        for (auto& layer : layers)
+            for (auto* buffer : layer->buffers()) tensors.push_back(buffer);
+        return tensors;
+    }
+
+    void begin_epoch() {
+        epoch_loss_sum_ = 0.0;
+        epoch_samples_ = 0;
+        epoch_start_ = std::chrono::steady_clock::now();
+    }
+
+    // La pérdida de cada batch ya sale de train_batch: acumularla no cuesta
+    // ningún forward extra.
+    void track_batch(T loss, size_t rows) {
+        epoch_loss_sum_ += static_cast<double>(loss) * static_cast<double>(rows);
+        epoch_samples_ += rows;
+    }
+
+    template<template <typename...> class LossType>
+    T validation_loss() const {
+        const auto& X = *validation_x_;
+        const auto& Y = *validation_y_;
+        const size_t rows = X.shape()[0], x_cols = X.shape()[1], y_cols = Y.shape()[1];
+        const size_t chunk = 1024;
+        double sum = 0.0;
+        for (size_t first = 0; first < rows; first += chunk) {
+            const size_t n = std::min(chunk, rows - first);
+            algebra::Tensor<T, 2> x(n, x_cols), y(n, y_cols);
+            std::copy(X.cbegin() + first * x_cols, X.cbegin() + (first + n) * x_cols, x.begin());
+            std::copy(Y.cbegin() + first * y_cols, Y.cbegin() + (first + n) * y_cols, y.begin());
+            sum += static_cast<double>(LossType<T>(infer(x), y).loss()) * static_cast<double>(n);
+        }
+        return rows ? static_cast<T>(sum / static_cast<double>(rows)) : T(0);
+    }
+
+    // Cierra la época: historial, validación, parada temprana y callback.
+    // Devuelve false si hay que dejar de entrenar.
+    template<template <typename...> class LossType>
+    bool finish_epoch() {
+        ++state_.epoch;
+        state_.batch = 0;
+
+        EpochStats<T> stats;
+        stats.epoch = state_.epoch;
+        stats.samples = epoch_samples_;
+        stats.learning_rate = current_rate_;
+        stats.train_loss = epoch_samples_ ? static_cast<T>(epoch_loss_sum_ / static_cast<double>(epoch_samples_)) : T(0);
+        if (validation_x_ && validate_every_ != 0 && state_.epoch % validate_every_ == 0) {
+            stats.validated = true;
+            stats.validation_loss = validation_loss<LossType>();
+        }
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch_start_).count();
+        history_.push_back(stats);
+
+        bool keep_going = true;
+        if (early_stopping_ && (!validation_x_ || stats.validated)) {
+            const double value = validation_x_ ? stats.validation_loss : stats.train_loss;
+            if (early_stopping_->observe(value, stats.epoch)) {
+                if (early_stopping_->restore_best) {
+                    best_params_.clear();
+                    for (auto* tensor : state_tensors()) best_params_.push_back(*tensor);
+                }
+            } else if (early_stopping_->should_stop()) {
+                if (early_stopping_->restore_best && !best_params_.empty()) {
+                    size_t index = 0;
+                    for (auto* tensor : state_tensors()) *tensor = best_params_[index++];
+                    plan_.reset();
+                }
+                keep_going = false;
+            }
+        }
+        if (epoch_callback_ && !epoch_callback_(stats)) keep_going = false;
+        stopped_ = !keep_going;
+        return keep_going;
+    }
+
+    // Un paso del optimizador sobre las filas [begin, begin + count) de X e Y,
+    // copiadas en trozos de a lo sumo micro_batch filas (0: de una vez). Si
+    // el rango es todo X y no hay que trocear, se usa sin copiar.
+    template<template <typename...> class LossType>
+    T train_rows(const algebra::Tensor<T, 2>& X, const algebra::Tensor<T, 2>& Y, size_t begin, size_t count,
+                 IOptimizer<T>& opt, size_t micro_batch) {
+        NN_PROFILE_SCOPE("train_batch", profiler::Phase::Step);
+        NN_TENSOR_SCOPE(tensor_site("train_batch", profiler::Phase::Step));
+        plan_.reset();
+        if (micro_batch == 0 || micro_batch > count) micro_batch = count;
+        if (micro_batch == count && begin == 0 && count == X.shape()[0]) {
+            const T loss_value = accumulate_gradients<LossType>(X, Y, T(1));
+            apply_gradients(opt, count);
+            return loss_value;
+        }
+        const size_t x_cols = X.shape()[1], y_cols = Y.shape()[1];
+        T loss_value = T(0);
+        for (size_t i = 0; i < count; i += micro_batch) {
+            const size_t current = std::min(micro_batch, count - i);
+            const size_t row = begin + i;
+
+            NN_TENSOR_SCOPE(tensor_site("batch", profiler::Phase::BatchCopy));
+            algebra::Tensor<T, 2> x_micro(current, x_cols);
+            algebra::Tensor<T, 2> y_micro(current, y_cols);
+
+            // Las filas son contiguas: se copia el bloque completo.
+            {
+                NN_PROFILE_SCOPE("batch", profiler::Phase::BatchCopy, 0, 2 * current * (x_cols + y_cols) * sizeof(T));
+                std::copy(X.cbegin() + row * x_cols, X.cbegin() + (row + current) * x_cols, x_micro.begin());
+                std::copy(Y.cbegin() + row * y_cols, Y.cbegin() + (row + current) * y_cols, y_micro.begin());
+            }
+            loss_value += accumulate_gradients<LossType>(x_micro, y_micro, T(current) / T(count), i != 0);
+        }
+        apply_gradients(opt, count);
+        return loss_value;
+    }
+
+    algebra::Tensor<T, 2> forward_range(algebra::Tensor<T, 2> x, size_t from, size_t to) {
+        [[maybe_unused]] const size_t rows = x.shape()[0];  // solo para el profiler
+        for (size_t l = from; l < to; ++l) {
+            NN_PROFILE_SCOPE(layer_label(*layers[l], l), profiler::Phase::Forward,
+                             layer_cost(*layers[l], profiler::Phase::Forward, rows, x.shape()[1]));
+            NN_TENSOR_SCOPE(tensor_site(layer_label(*layers[l], l), profiler::Phase::Forward));
+            x = layers[l]->forward(x);
+        }
+        return x;
+    }
+
+    algebra::Tensor<T, 2> backward_range(algebra::Tensor<T, 2> grad, size_t from, size_t to, bool accumulate) {
+        [[maybe_unused]] const size_t rows = grad.shape()[0];
+        for (size_t l = to; l-- > from;) {
+            NN_PROFILE_SCOPE(layer_label(*layers[l], l), profiler::Phase::Backward,
+                             layer_cost(*layers[l], profiler::Phase::Backward, rows, grad.shape()[1]));
+            NN_TENSOR_SCOPE(tensor_site(layer_label(*layers[l], l), profiler::Phase::Backward));
+            layers[l]->set_accumulate_gradients(accumulate);
+            grad = layers[l]->backward(grad);
+            layers[l]->set_accumulate_gradients(false);
+        }
+        return grad;
+    }
+
+    void clear_range(size_t from, size_t to) {
+        for (size_t l = from; l < to; ++l) layers[l]->clear_cache();
+    }
+
+    size_t segment_layers() const {
+        if (!recompute_) return std::max<size_t>(1, layers.size());
+        if (segment_layers_) return segment_layers_;
+        return std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(layers.size())))));
+    }
+
+    // Forward, pérdida y backward de un trozo del batch. `weight` es la
+    // fracción de filas del batch lógico que tiene el trozo: las pérdidas
+    // promedian por fila, así que escalar su gradiente por `weight` y sumar
+    // los trozos da el gradiente del batch completo. Devuelve la pérdida ya
+    // ponderada.
+    //
+    // Con checkpointing de activaciones el forward guarda solo la entrada de
+    // cada segmento y vacía las caches de sus capas; en backward cada
+    // segmento se recalcula desde su entrada justo antes de propagar por él.
+    // El recálculo no debe mover el estado de las capas (estadísticas de
+    // BatchNorm), así que sus buffers se restauran después.
+    template<template <typename...> class LossType>
+    T accumulate_gradients(const algebra::Tensor<T, 2>& x, const algebra::Tensor<T, 2>& y, T weight,
+                           bool accumulate = false) {
+        const size_t depth = layers.size(), segment = segment_layers();
+        std::vector<algebra::Tensor<T, 2>> boundaries;
+        auto predictions = x;
+        for (size_t from = 0; from < depth; from += segment) {
+            const size_t to = std::min(from + segment, depth);
+            if (to < depth) boundaries.push_back(predictions);
+            predictions = forward_range(std::move(predictions), from, to);
+            if (to < depth) clear_range(from, to);
+        }
+
+        algebra::Tensor<T, 2> loss_grad(0, 0);
+        T loss_value;
+        {
+            NN_PROFILE_SCOPE("loss", profiler::Phase::Loss, 3 * predictions.size(), 3 * predictions.size() * sizeof(T));
+            NN_TENSOR_SCOPE(tensor_site("loss", profiler::Phase::Loss));
+            LossType<T> loss_fn(predictions, y);
+            loss_grad = loss_fn.loss_gradient();
+            loss_value = loss_fn.loss() * weight;
+            if (weight != T(1))
+                for (auto& g : loss_grad) g *= weight;
+        }
+        predictions = algebra::Tensor<T, 2>(0, 0);
+
+        for (size_t seg = (depth + segment - 1) / segment; seg-- > 0;) {
+            const size_t from = seg * segment, to = std::min(from + segment, depth);
+            if (to < depth) {
+                std::vector<algebra::Tensor<T, 2>> saved;
+                for (size_t l = from; l < to; ++l)
+                    for (auto* buffer : layers[l]->buffers()) saved.push_back(*buffer);
+                forward_range(std::move(boundaries[seg]), from, to);
+                boundaries.pop_back();
+                size_t index = 0;
+                for (size_t l = from; l < to; ++l)
+                    for (auto* buffer : layers[l]->buffers()) *buffer = std::move(saved[index++]);
+            }
+            loss_grad = backward_range(std::move(loss_grad), from, to, accumulate);
+            if (recompute_) clear_range(from, to);
+        }
+        return loss_value;
+    }
+
+    void apply_gradients(IOptimizer<T>& opt, [[maybe_unused]] size_t rows) {
+        for (size_t l = 0; l < layers.size(); ++l) {
+            NN_PROFILE_SCOPE(layer_label(*layers[l], l), profiler::Phase::Update,
+                             layer_cost(*layers[l], profiler::Phase::Update, rows, 0));
+            NN_TENSOR_SCOPE(tensor_site(layer_label(*layers[l], l), profiler::Phase::Update));
+            layers[l]->update_params(opt);
+        }
+        {
+            NN_PROFILE_SCOPE("optimizer.step", profiler::Phase::Update);
+            NN_TENSOR_SCOPE(tensor_site("optimizer.step", profiler::Phase::Update));
+            opt.step();
+        }
+        ++state_.step;
+    }
+
 public:
     void add_layer(std::unique_ptr<ILayer<T>> layer) {
         layers.emplace_back(std::move(layer));
+        optimizer_.reset();
+        plan_.reset();
     }
 
+    // Un paso de entrenamiento (forward, pérdida, backward y actualización)
+    // sobre un batch ya armado. Devuelve la pérdida del batch. Con
+    // micro_batch > 0 el batch se procesa en trozos de a lo sumo esas filas
+    // que acumulan gradientes, y el optimizador actúa una sola vez.
+    template<template <typename...> class LossType>
+    T train_batch(
+        const algebra::Tensor<T, 2>& x_batch,
+        const algebra::Tensor<T, 2>& y_batch,
+        IOptimizer<T>& opt,
+        size_t micro_batch = 0
+    ) {
+        return train_rows<LossType>(x_batch, y_batch, 0, x_batch.shape()[0], opt, micro_batch);
+    }
+
+    // Si hay un checkpoint cargado, la primera época retoma desde el batch
+    // guardado en training_state(). Con micro_batch > 0 cada batch se copia y
+    // procesa en trozos de esas filas (ver train_batch): la memoria de las
+    // activaciones depende de micro_batch y no de batch_size.
     template<
         template <typename...> class LossType, 
         template <typename...> class OptimizerType = SGD
@@ -38,56 +428,322 @@ public:
         const algebra::Tensor<T, 2>& Y,
         const size_t epochs,
         const size_t batch_size,
-        T learning_rate
+        T learning_rate,
+        size_t micro_batch = 0
     ) {
         const size_t total = X.shape()[0];
         assert(total == Y.shape()[0]);
 
+        stopped_ = false;
         for (size_t epoch = 0; epoch < epochs; ++epoch) {
-            for (size_t i = 0; i < total; i += batch_size) {
+            begin_epoch();
+            for (size_t i = state_.batch * batch_size; i < total; i += batch_size) {
                 size_t current_batch = std::min(batch_size, total - i);
+                track_batch(train_rows<LossType>(X, Y, i, current_batch, optimizer<OptimizerType>(learning_rate),
+                                                 micro_batch),
+                            current_batch);
+                after_step<void>(nullptr);
+            }
+            if (!finish_epoch<LossType>()) break;
+        }
+    }
+
+    // Entrena consumiendo batches de un loader (p. ej. PrefetchLoader):
+    // `loader.next()` devuelve un puntero al batch o nullptr al fin de época.
+    // Si el loader expone save_position(), su posición entra en los checkpoints.
+    template<
+        template <typename...> class LossType,
+        template <typename...> class OptimizerType = SGD,
+        typename Loader
+    >
+    void train(Loader& loader, const size_t epochs, T learning_rate, size_t micro_batch = 0) {
+        stopped_ = false;
+        for (size_t epoch = 0; epoch < epochs; ++epoch) {
+            begin_epoch();
+            while (auto batch = loader.next()) {
+                track_batch(train_batch<LossType>(batch->x, batch->y, optimizer<OptimizerType>(learning_rate), micro_batch),
+                            batch->x.shape()[0]);
+                after_step(&loader);
+            }
+            if (!finish_epoch<LossType>()) break;
+        }
+    }
 
-                algebra::Tensor<T, 2> x_batch(current_batch, X.shape()[1]);
-                algebra::Tensor<T, 2> y_batch(current_batch, Y.shape()[1]);
+    // Programa de tasa de aprendizaje para train (ver nn_schedule.h), p. ej.
+    // set_lr_schedule(std::make_shared<Warmup<float>>(500, std::make_shared<Cosine<float>>(10000))).
+    void set_lr_schedule(std::shared_ptr<const LRSchedule<T>> schedule) {
+        schedule_ = std::move(schedule);
+    }
 
-                for (size_t j = 0; j < current_batch; ++j) {
-                    for (size_t k = 0; k < X.shape()[1]; ++k)
-                        x_batch(j, k) = X(i + j, k);
-                    for (size_t k = 0; k < Y.shape()[1]; ++k)
-                        y_batch(j, k) = Y(i + j, k);
-                }
+    // Valida sobre (X, Y) cada `every_epochs` épocas durante train. Los
+    // tensores no se copian: deben vivir mientras se entrena.
+    void set_validation(const algebra::Tensor<T, 2>& X, const algebra::Tensor<T, 2>& Y, size_t every_epochs = 1) {
+        if (X.shape()[0] != Y.shape()[0]) {
+            throw std::runtime_error("Validation inputs and targets have different sizes");
+        }
+        validation_x_ = &X;
+        validation_y_ = &Y;
+        validate_every_ = every_epochs;
+    }
+
+    void clear_validation() {
+        validation_x_ = validation_y_ = nullptr;
+    }
+
+    // Reinicia el progreso de la parada temprana: para reanudar, llamarlo
+    // antes de load_checkpoint, que restaura el guardado.
+    void enable_early_stopping(const EarlyStopping& early_stopping) {
+        early_stopping_ = early_stopping;
+        best_params_.clear();
+    }
+
+    void disable_early_stopping() {
+        early_stopping_.reset();
+        best_params_.clear();
+    }
+
+    // Se llama al final de cada época; si devuelve false, train termina ahí.
+    void on_epoch(EpochCallback<T> callback) {
+        epoch_callback_ = std::move(callback);
+    }
 
-                auto predictions = x_batch;
-                for (auto& layer : layers)
-                    predictions = layer->forward(predictions);
+    const std::vector<EpochStats<T>>& history() const {
+        return history_;
+    }
+
+    // true si el último train terminó antes de tiempo (parada temprana o
+    // callback).
+    bool stopped_early() const noexcept {
+        return stopped_;
+    }
+
+    // Poda gradual por magnitud durante train (ver PruningSchedule).
+    void enable_pruning(const PruningSchedule& schedule) {
+        pruner_ = std::make_unique<GradualPruner<T>>(schedule);
+    }
+
+    void disable_pruning() {
+        pruner_.reset();
+    }
+
+    // Reemplaza por SparseDense cada Dense con al menos `min_sparsity` de
+    // pesos en cero. Devuelve cuántas capas se convirtieron.
+    size_t sparsify(double min_sparsity = 0.5) {
+        size_t converted = 0;
+        for (auto& layer : layers) {
+            auto dense = dynamic_cast<Dense<T>*>(layer.get());
+            if (!dense || sparsity_of(*dense) < min_sparsity) continue;
+            layer = std::make_unique<SparseDense<T>>(*dense);
+            ++converted;
+        }
+        if (converted) {
+            optimizer_.reset();
+            plan_.reset();
+        }
+        return converted;
+    }
+
+    // Mete cada BatchNorm que sigue a un Dense en los pesos y sesgos de ese
+    // Dense (W[:, j] *= scale[j], b[j] = b[j] * scale[j] + shift[j]) y la
+    // quita de la red: para servir, la normalización no cuesta nada.
+    // Devuelve cuántas se plegaron; las que no siguen a un Dense quedan.
+    size_t fold_batch_norm() {
+        size_t folded = 0;
+        for (size_t l = 1; l < layers.size(); ++l) {
+            auto bn = dynamic_cast<BatchNorm<T>*>(layers[l].get());
+            auto dense = dynamic_cast<Dense<T>*>(layers[l - 1].get());
+            if (!bn || !dense || bn->features() != dense->out_features()) continue;
+            std::vector<T> scale(bn->features()), shift(bn->features());
+            bn->affine(scale.data(), shift.data());
+            auto params = dense->parameters();
+            auto& w = *params[0];
+            auto& b = *params[1];
+            const size_t in_f = w.shape()[0], out_f = w.shape()[1];
+            for (size_t i = 0; i < in_f; ++i)
+                for (size_t j = 0; j < out_f; ++j) w.data[i * out_f + j] *= scale[j];
+            for (size_t j = 0; j < out_f; ++j) b.data[j] = b.data[j] * scale[j] + shift[j];
+            layers.erase(layers.begin() + static_cast<std::ptrdiff_t>(l));
+            --l;
+            ++folded;
+        }
+        if (folded) {
+            optimizer_.reset();
+            plan_.reset();
+        }
+        return folded;
+    }
 
-                LossType<T> loss_fn(predictions, y_batch);
-                auto loss_grad = loss_fn.loss_gradient();
+    // Checkpointing de activaciones para train: el forward guarda solo la
+    // entrada de cada segmento de `segment_layers` capas, y en backward cada
+    // segmento se recalcula (un forward extra por paso). Con 0 se usan
+    // ⌈√capas⌉ capas por segmento: la memoria de activaciones queda en
+    // O(√capas) en lugar de O(capas).
+    void enable_activation_checkpointing(size_t segment_layers = 0) {
+        recompute_ = true;
+        segment_layers_ = segment_layers;
+    }
+
+    void disable_activation_checkpointing() {
+        recompute_ = false;
+    }
+
+    // Checkpoints asíncronos cada `every_steps` pasos del optimizador.
+    void enable_checkpoints(const std::string& path, size_t every_steps) {
+        checkpoint_writer_ = std::make_unique<AsyncCheckpointWriter<T>>(path);
+        checkpoint_every_ = every_steps;
+    }
 
-                for (auto it = layers.rbegin(); it != layers.rend(); ++it)
-                    loss_grad = (*it)->backward(loss_grad);
+    // Copia el estado actual (rápido, en este hilo) y lo encola para escribir.
+    void checkpoint_now() {
+        if (!checkpoint_writer_) {
+            throw std::runtime_error("Checkpoints are not enabled");
+        }
+        NN_TENSOR_SCOPE(tensor_site("checkpoint", profiler::Phase::Step));
+        CheckpointSnapshot<T> snapshot;
+        snapshot.state = state_;
+        for (auto* tensor : state_tensors())
+            snapshot.params.push_back(*tensor);
+        if (optimizer_) {
+            std::ostringstream out(std::ios::binary);
+            optimizer_->save_state(out);
+            snapshot.optimizer_state = out.str();
+        } else {
+            snapshot.optimizer_state = pending_optimizer_state_;
+        }
+        snapshot.early_stopping = early_stopping_;
+        snapshot.best_params = best_params_;
+        snapshot.history = history_;
+        checkpoint_writer_->submit(std::move(snapshot));
+    }
 
-                OptimizerType<T> opt(learning_rate);
+    void flush_checkpoints() {
+        if (checkpoint_writer_) checkpoint_writer_->flush();
+    }
 
-                for (auto& layer : layers)
-                    layer->update_params(opt);
+    // Restaura pesos, estado del optimizador, posición, historial y progreso
+    // de la parada temprana (si el checkpoint la tenía) desde un checkpoint.
+    // La red debe tener la misma arquitectura que cuando se guardó.
+    const TrainingState& load_checkpoint(const std::string& path) {
+        auto snapshot = checkpoint::read<T>(path);
+        size_t index = 0;
+        for (auto* tensor : state_tensors()) {
+            if (index >= snapshot.params.size() || snapshot.params[index].shape() != tensor->shape()) {
+                throw std::runtime_error("Checkpoint does not match the network architecture");
             }
+            *tensor = std::move(snapshot.params[index++]);
+        }
+        if (index != snapshot.params.size()) {
+            throw std::runtime_error("Checkpoint does not match the network architecture");
         }
+        optimizer_.reset();
+        plan_.reset();
+        pending_optimizer_state_ = std::move(snapshot.optimizer_state);
+        state_ = std::move(snapshot.state);
+        history_ = std::move(snapshot.history);
+        if (snapshot.early_stopping) {
+            early_stopping_ = snapshot.early_stopping;
+            best_params_ = std::move(snapshot.best_params);
+        }
+        return state_;
+    }
+
+    const TrainingState& training_state() const {
+        return state_;
+    }
+
+    // Contadores de Tensor por sitio ("0:Dense 784x128 forward", "loss loss",
+    // "train_batch step", ...). Vacío si no se compiló con
+    // UTEC_TENSOR_TELEMETRY. Los totales del proceso (memoria viva, pico)
+    // están en algebra::telemetry::totals().
+    const std::map<std::string, algebra::telemetry::Stats>& tensor_stats() const {
+        return tensor_stats_;
+    }
+
+    void reset_tensor_stats() {
+        tensor_stats_.clear();
+    }
+
+    // Empaqueta los pesos actuales para que predict no repita ese trabajo.
+    void build_plan() {
+        plan_ = std::make_unique<InferencePlan<T>>(layers);
+    }
+
+    bool has_plan() const noexcept {
+        return plan_ != nullptr;
     }
 
     algebra::Tensor<T, 2> predict(const algebra::Tensor<T, 2>& X) {
+        if (plan_) {
+            NN_PROFILE_SCOPE("InferencePlan", profiler::Phase::Predict);
+            NN_TENSOR_SCOPE(tensor_site("InferencePlan", profiler::Phase::Predict));
+            return plan_->run(X);
+        }
         auto predictions = X;
-        for (auto& layer : layers)
-            predictions = layer->forward(predictions);
+        for (size_t l = 0; l < layers.size(); ++l) {
+            NN_PROFILE_SCOPE(layer_label(*layers[l], l), profiler::Phase::Predict,
+                             layer_cost(*layers[l], profiler::Phase::Predict, X.shape()[0], predictions.shape()[1]));
+            NN_TENSOR_SCOPE(tensor_site(layer_label(*layers[l], l), profiler::Phase::Predict));
+            predictions = layers[l]->infer(predictions);
+        }
+        return predictions;
+    }
+
+    // Camino de baja latencia para una sola muestra (x: entradas de la
+    // primera capa, y: salidas de la última). Arma el plan si hace falta y,
+    // para redes Dense/ReLU/Sigmoid, no reserva memoria en cada llamada.
+    void predict_one(const T* x, T* y) {
+        if (!plan_) build_plan();
+        plan_->run_one(x, y);
+    }
+
+    // Inferencia const y reentrante: no toca el estado de las capas, así que
+    // muchos hilos pueden compartir una misma red mientras nadie la entrene
+    // ni la recargue. Usa el plan si ya está armado (infer nunca lo arma).
+    algebra::Tensor<T, 2> infer(const algebra::Tensor<T, 2>& X) const {
+        if (plan_) return plan_->run(X);
+        auto predictions = X;
+        for (const auto& layer : layers)
+            predictions = layer->infer(predictions);
         return predictions;
     }
 
+    // Una muestra con los buffers de `context` (uno por hilo). Requiere plan.
+    void infer_one(const T* x, T* y, InferenceContext<T>& context) const {
+        if (!plan_) {
+            throw std::runtime_error("infer_one needs an inference plan (call build_plan first)");
+        }
+        plan_->run_one(x, y, context);
+    }
+
+    void infer_one(const T* x, T* y) const {
+        thread_local InferenceContext<T> context;
+        infer_one(x, y, context);
+    }
+
     void save(const std::string& path) const {
         std::ofstream out(path);
         for (const auto& layer : layers) {
             if (auto dense = dynamic_cast<Dense<T>*>(layer.get())) {
                 out << "Dense\n";
                 dense->save(out);
+            } else if (auto sparse = dynamic_cast<SparseDense<T>*>(layer.get())) {
+                out << "SparseDense\n";
+                sparse->save(out);
+            } else if (auto bn = dynamic_cast<BatchNorm<T>*>(layer.get())) {
+                out << "BatchNorm\n";
+                bn->save(out);
+            } else if (auto dropout = dynamic_cast<Dropout<T>*>(layer.get())) {
+                out << "Dropout\n";
+                dropout->save(out);
+            } else if (auto conv = dynamic_cast<Conv2D<T>*>(layer.get())) {
+                out << "Conv2D\n";
+                conv->save(out);
+            } else if (auto pool = dynamic_cast<MaxPool2D<T>*>(layer.get())) {
+                out << "MaxPool2D\n";
+                pool->save(out);
+            } else if (auto pool = dynamic_cast<AvgPool2D<T>*>(layer.get())) {
+                out << "AvgPool2D\n";
+                pool->save(out);
             } else if (dynamic_cast<ReLU<T>*>(layer.get())) {
                 out << "ReLU\n";
             } else if (dynamic_cast<Sigmoid<T>*>(layer.get())) {
@@ -97,10 +753,52 @@ public:
         out.close();
     }
 
-    void load(const std::string& path) {
+    // Formato binario (ver nn_model_file.h): pesos en bruto, alineados y con
+    // checksum; mucho más chico y rápido de cargar que el texto.
+    void save_binary(const std::string& path) const {
+        model_file::write<T>(layers, path);
+    }
+
+    // Con in_place los Dense referencian los pesos dentro del archivo mapeado.
+    void load_binary(const std::string& path, bool in_place = true) {
+        layers = model_file::read<T>(path, in_place);
+        optimizer_.reset();
+        plan_.reset();
+    }
+
+    // Carga para servir muchas réplicas: los pesos quedan como vistas sobre
+    // un mapeo de solo lectura que comparten todas las instancias del proceso
+    // y, vía page cache, los demás procesos. Un modelo en texto se convierte
+    // una vez a `path.nnb`, con las BatchNorm ya plegadas. No arma plan de
+    // inferencia, porque empaquetar copiaría los pesos a memoria privada.
+    void load_shared(const std::string& path) {
+        namespace fs = std::filesystem;
+        std::string binary = path;
+        if (!model_file::is_model_file(path)) {
+            binary = path + ".nnb";
+            if (!fs::exists(binary) || fs::last_write_time(binary) < fs::last_write_time(path)) {
+                NeuralNetwork<T> text;
+                text.load(path);
+                text.fold_batch_norm();
+                text.save_binary(binary);
+            }
+        }
+        load_binary(binary, true);
+    }
+
+    // Con with_plan la red se carga para servir: se pliegan las BatchNorm en
+    // los Dense (fold_batch_norm) y se arma el plan de inferencia.
+    void load(const std::string& path, bool with_plan = false) {
+        if (model_file::is_model_file(path)) {
+            load_binary(path);
+            if (with_plan) build_plan();
+            return;
+        }
         std::ifstream in(path);
         std::string type;
         layers.clear();
+        optimizer_.reset();
+        plan_.reset();
 
         while (in >> type) {
             if (type == "Dense") {
@@ -111,6 +809,30 @@ public:
                 );
                 dense->load(in);
                 layers.push_back(std::move(dense));
+            } else if (type == "SparseDense") {
+                auto sparse = std::make_unique<SparseDense<T>>();
+                sparse->load(in);
+                layers.push_back(std::move(sparse));
+            } else if (type == "BatchNorm") {
+                auto bn = std::make_unique<BatchNorm<T>>();
+                bn->load(in);
+                layers.push_back(std::move(bn));
+            } else if (type == "Dropout") {
+                auto dropout = std::make_unique<Dropout<T>>();
+                dropout->load(in);
+                layers.push_back(std::move(dropout));
+            } else if (type == "Conv2D") {
+                auto conv = std::make_unique<Conv2D<T>>();
+                conv->load(in);
+                layers.push_back(std::move(conv));
+            } else if (type == "MaxPool2D") {
+                auto pool = std::make_unique<MaxPool2D<T>>();
+                pool->load(in);
+                layers.push_back(std::move(pool));
+            } else if (type == "AvgPool2D") {
+                auto pool = std::make_unique<AvgPool2D<T>>();
+                pool->load(in);
+                layers.push_back(std::move(pool));
             } else if (type == "ReLU") {
                 layers.push_back(std::make_unique<ReLU<T>>());
             } else if (type == "Sigmoid") {
@@ -118,6 +840,10 @@ public:
             }
         }
         in.close();
+        if (with_plan) {
+            fold_batch_norm();
+            build_plan();
+        }
     }
 
     const std::vector<std::unique_ptr<ILayer<T>>>& dlayers() const {
@@ -44,6 +44,10 @@ namespace utec
 
             algebra::Tensor<T, 2> forward(const algebra::Tensor<T, 2>& z) override {
                 input = z;
+                return infer(z);
+            }
+
+            algebra::Tensor<T, 2> infer(const algebra::Tensor<T, 2>& z) const override {
                 auto shape = z.shape();
                 algebra::Tensor<T, 2> result(shape[0], shape[1]);
                 for (size_t i = 0; i < shape[0]; ++i) {
@@ -64,6 +68,10 @@ namespace utec
                 }
                 return grand;
             }
+
+            void clear_cache() override {
+                input = algebra::Tensor<T, 2>(0, 0);
+            }
         };
         template<typename T>
         class Sigmoid final : public ILayer<T> {
@@ -77,14 +85,19 @@ namespace utec
             Sigmoid() : output(1, 1) {}
 
             algebra::Tensor<T, 2> forward(const algebra::Tensor<T, 2>& z) override {
+                output = infer(z);
+                return output;
+            }
+
+            algebra::Tensor<T, 2> infer(const algebra::Tensor<T, 2>& z) const override {
                 auto shape = z.shape();
-                output = algebra::Tensor<T, 2>(shape[0], shape[1]);
+                algebra::Tensor<T, 2> result(shape[0], shape[1]);
                 for (size_t i = 0; i < shape[0]; ++i) {
                     for (size_t j = 0; j < shape[1]; ++j) {
-                        output(i, j) = sigmoid(z(i, j));
+                        result(i, j) = sigmoid(z(i, j));
                     }
                 }
-                return output;
+                return result;
             }
 
             algebra::Tensor<T, 2> backward(const algebra::Tensor<T, 2>& g) override {
@@ -98,6 +111,10 @@ namespace utec
                 }
                 return grand;
             }
+
+            void clear_cache() override {
+                output = algebra::Tensor<T, 2>(0, 0);
+            }
         };
     } // namespace neural_network
     
@@ -0,0 +1,230 @@
+//
+// Normalización por batch sobre las columnas (features) de un Tensor<T, 2>.
+//
+// forward normaliza con la media y varianza del batch y actualiza las
+// estadísticas móviles (con una sola fila usa las móviles sin tocarlas: la
+// varianza del batch sería 0); infer usa las móviles, así que predict y el plan de
+// inferencia ven una transformación afín fija por feature. Esa forma afín es
+// la que NeuralNetwork::fold_batch_norm mete en el Dense anterior.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_BATCHNORM_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_BATCHNORM_H
+
+#include "nn_interfaces.h"
+#include "../algebra/tensor.h"
+#include <cmath>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+namespace utec::neural_network {
+
+template<typename T>
+class BatchNorm final : public ILayer<T> {
+private:
+    size_t features_ = 0;
+    T momentum_ = T(0.1);
+    T eps_ = T(1e-5);
+    algebra::Tensor<T, 2> gamma;          // 1 x features
+    algebra::Tensor<T, 2> beta;
+    algebra::Tensor<T, 2> running_mean;
+    algebra::Tensor<T, 2> running_var;
+    algebra::Tensor<T, 2> grad_gamma;
+    algebra::Tensor<T, 2> grad_beta;
+    algebra::Tensor<T, 2> x_hat;          // entrada normalizada del último forward
+    std::vector<T> inv_std_;
+    bool running_stats_ = false;          // el último forward usó las móviles
+    bool accumulate_ = false;
+
+    void check(const algebra::Tensor<T, 2>& x) const {
+        if (x.shape()[1] != features_) throw std::runtime_error("BatchNorm feature count mismatch");
+    }
+
+    void allocate() {
+        gamma = algebra::Tensor<T, 2>(1, features_);
+        beta = algebra::Tensor<T, 2>(1, features_);
+        running_mean = algebra::Tensor<T, 2>(1, features_);
+        running_var = algebra::Tensor<T, 2>(1, features_);
+        grad_gamma = algebra::Tensor<T, 2>(1, features_);
+        grad_beta = algebra::Tensor<T, 2>(1, features_);
+        gamma.fill(T(1));
+        running_var.fill(T(1));
+    }
+
+public:
+    BatchNorm() : gamma(1, 0), beta(1, 0), running_mean(1, 0), running_var(1, 0),
+                  grad_gamma(1, 0), grad_beta(1, 0), x_hat(0, 0) {}
+
+    explicit BatchNorm(size_t features, T momentum = T(0.1), T eps = T(1e-5))
+        : features_(features), momentum_(momentum), eps_(eps),
+          gamma(1, features), beta(1, features), running_mean(1, features), running_var(1, features),
+          grad_gamma(1, features), grad_beta(1, features), x_hat(0, features) {
+        if (features == 0 || momentum <= T(0) || momentum > T(1) || eps <= T(0)) {
+            throw std::runtime_error("Invalid BatchNorm configuration");
+        }
+        gamma.fill(T(1));
+        running_var.fill(T(1));
+    }
+
+    // Las sumas recorren el batch por filas, con el bucle interno sobre las
+    // features contiguas, y la salida se escribe en la misma pasada que x_hat.
+    algebra::Tensor<T, 2> forward(const algebra::Tensor<T, 2>& x) override {
+        check(x);
+        const size_t n = x.shape()[0], f = features_;
+        std::vector<T> mean(f, T(0)), var(f, T(0));
+        inv_std_.resize(f);
+        // Una fila (último batch de la época, micro-batch de 1): con la
+        // varianza del batch en 0 la salida sería beta para cualquier entrada.
+        running_stats_ = n == 1;
+        if (running_stats_) {
+            for (size_t j = 0; j < f; ++j) {
+                mean[j] = running_mean.data[j];
+                inv_std_[j] = T(1) / std::sqrt(running_var.data[j] + eps_);
+            }
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                const T* row = x.data.data() + i * f;
+                for (size_t j = 0; j < f; ++j) mean[j] += row[j];
+            }
+            for (size_t j = 0; j < f; ++j) mean[j] /= T(n);
+            for (size_t i = 0; i < n; ++i) {
+                const T* row = x.data.data() + i * f;
+                for (size_t j = 0; j < f; ++j) {
+                    const T d = row[j] - mean[j];
+                    var[j] += d * d;
+                }
+            }
+            for (size_t j = 0; j < f; ++j) {
+                var[j] /= T(n);
+                inv_std_[j] = T(1) / std::sqrt(var[j] + eps_);
+                running_mean.data[j] += momentum_ * (mean[j] - running_mean.data[j]);
+                running_var.data[j] += momentum_ * (var[j] * T(n) / T(n - 1) - running_var.data[j]);
+            }
+        }
+
+        x_hat = algebra::Tensor<T, 2>(n, f);
+        algebra::Tensor<T, 2> out(n, f);
+        const T* g = gamma.data.data();
+        const T* b = beta.data.data();
+        for (size_t i = 0; i < n; ++i) {
+            const T* row = x.data.data() + i * f;
+            T* h = x_hat.data.data() + i * f;
+            T* o = out.data.data() + i * f;
+            for (size_t j = 0; j < f; ++j) {
+                h[j] = (row[j] - mean[j]) * inv_std_[j];
+                o[j] = g[j] * h[j] + b[j];
+            }
+        }
+        return out;
+    }
+
+    algebra::Tensor<T, 2> infer(const algebra::Tensor<T, 2>& x) const override {
+        check(x);
+        std::vector<T> scale(features_), shift(features_);
+        affine(scale.data(), shift.data());
+        algebra::Tensor<T, 2> out(x.shape()[0], features_);
+        for (size_t i = 0; i < x.shape()[0]; ++i) {
+            const T* row = x.data.data() + i * features_;
+            T* o = out.data.data() + i * features_;
+            for (size_t j = 0; j < features_; ++j) o[j] = row[j] * scale[j] + shift[j];
+        }
+        return out;
+    }
+
+    // dx = gamma * inv_std / n * (n * dy - sum(dy) - x_hat * sum(dy * x_hat)),
+    // con las dos sumas por feature en una sola pasada. Si forward usó las
+    // estadísticas móviles son constantes: dx = gamma * inv_std * dy.
+    algebra::Tensor<T, 2> backward(const algebra::Tensor<T, 2>& dY) override {
+        const size_t n = dY.shape()[0], f = features_;
+        std::vector<T> sum_dy(f, T(0)), sum_dy_xhat(f, T(0));
+        for (size_t i = 0; i < n; ++i) {
+            const T* d = dY.data.data() + i * f;
+            const T* h = x_hat.data.data() + i * f;
+            for (size_t j = 0; j < f; ++j) {
+                sum_dy[j] += d[j];
+                sum_dy_xhat[j] += d[j] * h[j];
+            }
+        }
+        if (!accumulate_) {
+            grad_gamma.fill(T(0));
+            grad_beta.fill(T(0));
+        }
+        for (size_t j = 0; j < f; ++j) {
+            grad_beta.data[j] += sum_dy[j];
+            grad_gamma.data[j] += sum_dy_xhat[j];
+        }
+        std::vector<T> k(f);
+        algebra::Tensor<T, 2> dX(n, f);
+        if (running_stats_) {
+            for (size_t j = 0; j < f; ++j) k[j] = gamma.data[j] * inv_std_[j];
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < f; ++j) dX.data[i * f + j] = k[j] * dY.data[i * f + j];
+            return dX;
+        }
+        for (size_t j = 0; j < f; ++j) k[j] = gamma.data[j] * inv_std_[j] / T(n);
+        for (size_t i = 0; i < n; ++i) {
+            const T* d = dY.data.data() + i * f;
+            const T* h = x_hat.data.data() + i * f;
+            T* o = dX.data.data() + i * f;
+            for (size_t j = 0; j < f; ++j)
+                o[j] = k[j] * (T(n) * d[j] - sum_dy[j] - h[j] * sum_dy_xhat[j]);
+        }
+        return dX;
+    }
+
+    void clear_cache() override {
+        x_hat = algebra::Tensor<T, 2>(0, 0);
+    }
+
+    void set_accumulate_gradients(bool accumulate) override {
+        accumulate_ = accumulate;
+    }
+
+    void update_params(IOptimizer<T>& optimizer) override {
+        optimizer.update(gamma, grad_gamma, ParamKind::Bias);
+        optimizer.update(beta, grad_beta, ParamKind::Bias);
+    }
+
+    std::vector<algebra::Tensor<T, 2>*> parameters() override {
+        return {&gamma, &beta};
+    }
+
+    std::vector<algebra::Tensor<T, 2>*> buffers() override {
+        return {&running_mean, &running_var};
+    }
+
+    // Inferencia como y = x * scale + shift por feature.
+    void affine(T* scale, T* shift) const {
+        for (size_t j = 0; j < features_; ++j) {
+            scale[j] = gamma.data[j] / std::sqrt(running_var.data[j] + eps_);
+            shift[j] = beta.data[j] - running_mean.data[j] * scale[j];
+        }
+    }
+
+    void save(std::ostream& out) const {
+        out << features_ << " " << momentum_ << " " << eps_ << "\n";
+        for (const auto* t : {&gamma, &beta, &running_mean, &running_var}) {
+            for (const T& v : t->data) out << v << " ";
+            out << "\n";
+        }
+    }
+
+    void load(std::istream& in) {
+        in >> features_ >> momentum_ >> eps_;
+        if (!in || features_ == 0) throw std::runtime_error("Corrupt BatchNorm layer");
+        allocate();
+        for (auto* t : {&gamma, &beta, &running_mean, &running_var})
+            for (auto& v : *t) in >> v;
+        if (!in) throw std::runtime_error("Corrupt BatchNorm layer");
+    }
+
+    size_t features() const noexcept { return features_; }
+    T momentum() const noexcept { return momentum_; }
+    T eps() const noexcept { return eps_; }
+};
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_BATCHNORM_H
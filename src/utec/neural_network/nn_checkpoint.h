@@ -0,0 +1,303 @@
+//
+// Checkpoints de entrenamiento: pesos, estado del optimizador, contador de
+// pasos, posición del loader y seguimiento por época (parada temprana e
+// historial). El snapshot se copia en memoria en el hilo de entrenamiento y
+// se codifica/escribe a disco en un hilo de fondo.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_CHECKPOINT_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_CHECKPOINT_H
+
+#include "nn_optimizer.h"
+#include "nn_model_file.h"
+#include "nn_training.h"
+#include <vector>
+#include <string>
+#include <optional>
+#include <sstream>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <filesystem>
+#include <chrono>
+#include <cstring>
+
+namespace utec::neural_network {
+
+// Posición del entrenamiento: época en curso, próximo batch dentro de ella,
+// pasos del optimizador y estado opaco del loader (orden y RNG).
+struct TrainingState {
+    size_t epoch = 0;
+    size_t batch = 0;
+    uint64_t step = 0;
+    std::string loader_state;
+};
+
+template<typename T>
+struct CheckpointSnapshot {
+    TrainingState state;
+    std::vector<algebra::Tensor<T, 2>> params;
+    std::string optimizer_state;
+
+    // Sin esto, reanudar reiniciaría la paciencia y perdería los pesos de la
+    // mejor época.
+    std::optional<EarlyStopping> early_stopping;
+    std::vector<algebra::Tensor<T, 2>> best_params;
+    std::vector<EpochStats<T>> history;
+};
+
+namespace checkpoint {
+
+constexpr char MAGIC[4] = {'U', 'T', 'C', 'K'};
+// Versión 2 agrega la parada temprana y el historial; la 1 se sigue leyendo.
+constexpr uint32_t VERSION = 2;
+
+inline void write_string(std::ostream& out, const std::string& s) {
+    detail::write_pod(out, static_cast<uint64_t>(s.size()));
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+inline std::string read_string(std::istream& in) {
+    uint64_t size = 0;
+    detail::read_pod(in, size);
+    std::string s(static_cast<size_t>(size), '\0');
+    if (!in.read(s.data(), static_cast<std::streamsize>(size)))
+        throw std::runtime_error("Truncated checkpoint");
+    return s;
+}
+
+// Escribe en `path.tmp` y renombra: un corte a mitad de escritura nunca
+// deja un checkpoint corrupto en `path`.
+template<typename T>
+void write(const CheckpointSnapshot<T>& snapshot, const std::string& path) {
+    std::ostringstream body(std::ios::binary);
+    detail::write_pod(body, static_cast<uint64_t>(snapshot.state.epoch));
+    detail::write_pod(body, static_cast<uint64_t>(snapshot.state.batch));
+    detail::write_pod(body, snapshot.state.step);
+    write_string(body, snapshot.state.loader_state);
+    detail::write_tensors(body, snapshot.params);
+    write_string(body, snapshot.optimizer_state);
+
+    detail::write_pod(body, static_cast<uint8_t>(snapshot.early_stopping.has_value()));
+    if (const auto& es = snapshot.early_stopping) {
+        detail::write_pod(body, static_cast<uint64_t>(es->patience));
+        detail::write_pod(body, es->min_delta);
+        detail::write_pod(body, static_cast<uint8_t>(es->restore_best));
+        detail::write_pod(body, es->best);
+        detail::write_pod(body, static_cast<uint64_t>(es->best_epoch));
+        detail::write_pod(body, static_cast<uint64_t>(es->waiting));
+    }
+    detail::write_tensors(body, snapshot.best_params);
+    detail::write_pod(body, static_cast<uint64_t>(snapshot.history.size()));
+    for (const auto& stats : snapshot.history) {
+        detail::write_pod(body, static_cast<uint64_t>(stats.epoch));
+        detail::write_pod(body, stats.train_loss);
+        detail::write_pod(body, static_cast<uint64_t>(stats.samples));
+        detail::write_pod(body, stats.learning_rate);
+        detail::write_pod(body, static_cast<uint8_t>(stats.validated));
+        detail::write_pod(body, stats.validation_loss);
+        detail::write_pod(body, stats.seconds);
+    }
+    const std::string bytes = body.str();
+
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        if (!out) {
+            throw std::runtime_error("Cannot write " + tmp);
+        }
+        out.write(MAGIC, sizeof(MAGIC));
+        detail::write_pod(out, VERSION);
+        detail::write_pod(out, static_cast<uint32_t>(sizeof(T)));
+        detail::write_pod(out, model_file::crc32(bytes.data(), bytes.size()));
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!out.flush()) {
+            throw std::runtime_error("Cannot write " + tmp);
+        }
+    }
+    std::filesystem::rename(tmp, path);
+}
+
+template<typename T>
+CheckpointSnapshot<T> read(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    char magic[4];
+    uint32_t version = 0, dtype_size = 0, crc = 0;
+    in.read(magic, sizeof(magic));
+    detail::read_pod(in, version);
+    detail::read_pod(in, dtype_size);
+    detail::read_pod(in, crc);
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version == 0 || version > VERSION) {
+        throw std::runtime_error("Not a checkpoint file: " + path);
+    }
+    if (dtype_size != sizeof(T)) {
+        throw std::runtime_error("Checkpoint dtype does not match the network type");
+    }
+    const std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (model_file::crc32(bytes.data(), bytes.size()) != crc) {
+        throw std::runtime_error("Checkpoint checksum mismatch in " + path);
+    }
+
+    std::istringstream body(bytes, std::ios::binary);
+    CheckpointSnapshot<T> snapshot;
+    uint64_t epoch = 0, batch = 0;
+    detail::read_pod(body, epoch);
+    detail::read_pod(body, batch);
+    detail::read_pod(body, snapshot.state.step);
+    snapshot.state.epoch = static_cast<size_t>(epoch);
+    snapshot.state.batch = static_cast<size_t>(batch);
+    snapshot.state.loader_state = read_string(body);
+    detail::read_tensors(body, snapshot.params);
+    snapshot.optimizer_state = read_string(body);
+    if (version < 2) return snapshot;
+
+    uint8_t flag = 0;
+    detail::read_pod(body, flag);
+    if (flag) {
+        EarlyStopping es;
+        uint64_t patience = 0, best_epoch = 0, waiting = 0;
+        uint8_t restore_best = 0;
+        detail::read_pod(body, patience);
+        detail::read_pod(body, es.min_delta);
+        detail::read_pod(body, restore_best);
+        detail::read_pod(body, es.best);
+        detail::read_pod(body, best_epoch);
+        detail::read_pod(body, waiting);
+        es.patience = static_cast<size_t>(patience);
+        es.restore_best = restore_best != 0;
+        es.best_epoch = static_cast<size_t>(best_epoch);
+        es.waiting = static_cast<size_t>(waiting);
+        snapshot.early_stopping = es;
+    }
+    detail::read_tensors(body, snapshot.best_params);
+    uint64_t epochs = 0;
+    detail::read_pod(body, epochs);
+    for (uint64_t e = 0; e < epochs; ++e) {
+        EpochStats<T> stats;
+        uint64_t epoch = 0, samples = 0;
+        uint8_t validated = 0;
+        detail::read_pod(body, epoch);
+        detail::read_pod(body, stats.train_loss);
+        detail::read_pod(body, samples);
+        detail::read_pod(body, stats.learning_rate);
+        detail::read_pod(body, validated);
+        detail::read_pod(body, stats.validation_loss);
+        detail::read_pod(body, stats.seconds);
+        stats.epoch = static_cast<size_t>(epoch);
+        stats.samples = static_cast<size_t>(samples);
+        stats.validated = validated != 0;
+        snapshot.history.push_back(stats);
+    }
+    return snapshot;
+}
+
+} // namespace checkpoint
+
+// Escritor en segundo plano. Guarda como máximo un snapshot pendiente: si
+// llega uno nuevo antes de empezar a escribir el anterior, lo reemplaza.
+template<typename T>
+class AsyncCheckpointWriter {
+private:
+    std::string path_;
+    std::optional<CheckpointSnapshot<T>> pending_;
+    bool writing_ = false;
+    bool stop_ = false;
+    size_t written_ = 0;
+    double write_seconds_ = 0.0;
+    std::string error_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable idle_cv_;
+    std::thread worker_;
+
+    void loop() {
+        while (true) {
+            CheckpointSnapshot<T> snapshot;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stop_ || pending_.has_value(); });
+                if (!pending_) return;
+                snapshot = std::move(*pending_);
+                pending_.reset();
+                writing_ = true;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            std::string error;
+            try {
+                checkpoint::write(snapshot, path_);
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+            auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                writing_ = false;
+                write_seconds_ += elapsed;
+                if (error.empty()) ++written_;
+                else error_ = error;
+            }
+            idle_cv_.notify_all();
+        }
+    }
+
+public:
+    explicit AsyncCheckpointWriter(std::string path) : path_(std::move(path)) {
+        worker_ = std::thread(&AsyncCheckpointWriter::loop, this);
+    }
+
+    AsyncCheckpointWriter(const AsyncCheckpointWriter&) = delete;
+    AsyncCheckpointWriter& operator=(const AsyncCheckpointWriter&) = delete;
+
+    // Termina de escribir lo pendiente antes de salir.
+    ~AsyncCheckpointWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    void submit(CheckpointSnapshot<T> snapshot) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_ = std::move(snapshot);
+        }
+        cv_.notify_one();
+    }
+
+    // Espera a que no quede nada por escribir; lanza si la última escritura falló.
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_cv_.wait(lock, [this] { return !pending_ && !writing_; });
+        if (!error_.empty()) {
+            std::string error = std::move(error_);
+            error_.clear();
+            throw std::runtime_error("Checkpoint write failed: " + error);
+        }
+    }
+
+    const std::string& path() const { return path_; }
+
+    size_t written() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return written_;
+    }
+
+    double write_seconds() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return write_seconds_;
+    }
+};
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_CHECKPOINT_H
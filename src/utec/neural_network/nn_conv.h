@@ -0,0 +1,369 @@
+//
+// Convolución 2D y pooling sobre imágenes NCHW.
+//
+// Las capas siguen recibiendo Tensor<T, 2>: cada fila es una muestra con sus
+// C x H x W valores en orden NCHW (canal, fila, columna), que es justo como
+// vienen los pixeles de MNIST. La convolución arma im2col para todo el batch
+// (una fila por posición de salida, una columna por canal x ky x kx) y hace
+// un solo matrix_product contra los filtros.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_CONV_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_CONV_H
+
+#include "nn_interfaces.h"
+#include "../algebra/tensor.h"
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+#include <stdexcept>
+
+namespace utec::neural_network {
+
+template<typename T>
+class Conv2D final : public ILayer<T> {
+private:
+    size_t in_c_ = 0, in_h_ = 0, in_w_ = 0;
+    size_t out_c_ = 0, k_ = 1, stride_ = 1, pad_ = 0;
+    size_t out_h_ = 0, out_w_ = 0;
+    algebra::Tensor<T, 2> weights;   // (in_c * k * k) x out_c
+    algebra::Tensor<T, 2> biases;    // 1 x out_c
+    algebra::Tensor<T, 2> cols;      // im2col del último forward
+    algebra::Tensor<T, 2> grad_w;
+    algebra::Tensor<T, 2> grad_b;
+    bool accumulate_ = false;
+
+    void set_geometry() {
+        if (k_ == 0 || stride_ == 0 || in_h_ + 2 * pad_ < k_ || in_w_ + 2 * pad_ < k_) {
+            throw std::runtime_error("Invalid Conv2D geometry");
+        }
+        out_h_ = (in_h_ + 2 * pad_ - k_) / stride_ + 1;
+        out_w_ = (in_w_ + 2 * pad_ - k_) / stride_ + 1;
+    }
+
+    algebra::Tensor<T, 2> im2col(const algebra::Tensor<T, 2>& x) const {
+        if (x.shape()[1] != input_size()) {
+            throw std::runtime_error("Conv2D input size does not match its geometry");
+        }
+        const size_t n = x.shape()[0], positions = out_h_ * out_w_, patch = in_c_ * k_ * k_;
+        algebra::Tensor<T, 2> out(n * positions, patch);
+        for (size_t s = 0; s < n; ++s) {
+            const T* image = x.data.data() + s * input_size();
+            for (size_t oy = 0; oy < out_h_; ++oy) {
+                for (size_t ox = 0; ox < out_w_; ++ox) {
+                    T* row = out.data.data() + ((s * out_h_ + oy) * out_w_ + ox) * patch;
+                    for (size_t c = 0; c < in_c_; ++c) {
+                        for (size_t ky = 0; ky < k_; ++ky) {
+                            const long iy = long(oy * stride_ + ky) - long(pad_);
+                            for (size_t kx = 0; kx < k_; ++kx) {
+                                const long ix = long(ox * stride_ + kx) - long(pad_);
+                                const bool inside = iy >= 0 && iy < long(in_h_) && ix >= 0 && ix < long(in_w_);
+                                *row++ = inside ? image[(c * in_h_ + size_t(iy)) * in_w_ + size_t(ix)] : T(0);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+    // (n * posiciones) x out_c -> n x (out_c * posiciones) más el sesgo.
+    algebra::Tensor<T, 2> to_nchw(const algebra::Tensor<T, 2>& product, size_t n) const {
+        const size_t positions = out_h_ * out_w_;
+        algebra::Tensor<T, 2> out(n, output_size());
+        for (size_t s = 0; s < n; ++s)
+            for (size_t p = 0; p < positions; ++p) {
+                const T* src = product.data.data() + (s * positions + p) * out_c_;
+                T* dst = out.data.data() + s * output_size() + p;
+                for (size_t oc = 0; oc < out_c_; ++oc)
+                    dst[oc * positions] = src[oc] + biases.data[oc];
+            }
+        return out;
+    }
+
+public:
+    Conv2D() : weights(1, 0), biases(1, 0), cols(0, 0), grad_w(1, 0), grad_b(1, 0) {}
+
+    // Entrada: in_channels x height x width por muestra. Filtros cuadrados
+    // de `kernel` con paso `stride` y `padding` ceros alrededor.
+    template<typename InitWFun, typename InitBFun>
+    Conv2D(size_t in_channels, size_t height, size_t width, size_t out_channels, size_t kernel,
+           InitWFun init_w_fun, InitBFun init_b_fun, size_t stride = 1, size_t padding = 0)
+        : in_c_(in_channels), in_h_(height), in_w_(width), out_c_(out_channels), k_(kernel),
+          stride_(stride), pad_(padding),
+          weights(in_channels * kernel * kernel, out_channels), biases(1, out_channels), cols(0, 0),
+          grad_w(in_channels * kernel * kernel, out_channels), grad_b(1, out_channels) {
+        set_geometry();
+        init_w_fun(weights);
+        init_b_fun(biases);
+    }
+
+    algebra::Tensor<T, 2> forward(const algebra::Tensor<T, 2>& x) override {
+        cols = im2col(x);
+        return to_nchw(algebra::matrix_product(cols, weights), x.shape()[0]);
+    }
+
+    algebra::Tensor<T, 2> infer(const algebra::Tensor<T, 2>& x) const override {
+        return to_nchw(algebra::matrix_product(im2col(x), weights), x.shape()[0]);
+    }
+
+    algebra::Tensor<T, 2> backward(const algebra::Tensor<T, 2>& dZ) override {
+        const size_t n = dZ.shape()[0], positions = out_h_ * out_w_, patch = in_c_ * k_ * k_;
+        algebra::Tensor<T, 2> d_out(n * positions, out_c_);
+        if (!accumulate_) {
+            grad_w.fill(T(0));
+            grad_b.fill(T(0));
+        }
+        for (size_t s = 0; s < n; ++s)
+            for (size_t oc = 0; oc < out_c_; ++oc)
+                for (size_t p = 0; p < positions; ++p) {
+                    const T g = dZ.data[s * output_size() + oc * positions + p];
+                    d_out.data[(s * positions + p) * out_c_ + oc] = g;
+                    grad_b.data[oc] += g;
+                }
+        algebra::accumulate_transposed_product(grad_w, cols, d_out);
+        const auto d_cols = algebra::matrix_product(d_out, algebra::transpose_2d(weights));
+
+        // col2im: cada posición de la ventana devuelve su gradiente al pixel.
+        algebra::Tensor<T, 2> dX(n, input_size());
+        for (size_t s = 0; s < n; ++s) {
+            T* image = dX.data.data() + s * input_size();
+            for (size_t oy = 0; oy < out_h_; ++oy)
+                for (size_t ox = 0; ox < out_w_; ++ox) {
+                    const T* row = d_cols.data.data() + ((s * out_h_ + oy) * out_w_ + ox) * patch;
+                    for (size_t c = 0; c < in_c_; ++c)
+                        for (size_t ky = 0; ky < k_; ++ky) {
+                            const long iy = long(oy * stride_ + ky) - long(pad_);
+                            for (size_t kx = 0; kx < k_; ++kx, ++row) {
+                                const long ix = long(ox * stride_ + kx) - long(pad_);
+                                if (iy >= 0 && iy < long(in_h_) && ix >= 0 && ix < long(in_w_))
+                                    image[(c * in_h_ + size_t(iy)) * in_w_ + size_t(ix)] += *row;
+                            }
+                        }
+                }
+        }
+        return dX;
+    }
+
+    void clear_cache() override {
+        cols = algebra::Tensor<T, 2>(0, 0);
+    }
+
+    void set_accumulate_gradients(bool accumulate) override {
+        accumulate_ = accumulate;
+    }
+
+    void update_params(IOptimizer<T>& optimizer) override {
+        optimizer.update(weights, grad_w, ParamKind::Weight);
+        optimizer.update(biases, grad_b, ParamKind::Bias);
+    }
+
+    std::vector<algebra::Tensor<T, 2>*> parameters() override {
+        return {&weights, &biases};
+    }
+
+    void save(std::ostream& out) const {
+        out << in_c_ << " " << in_h_ << " " << in_w_ << " " << out_c_ << " " << k_ << " "
+            << stride_ << " " << pad_ << "\n";
+        for (const T& w : weights.data) out << w << " ";
+        out << "\n";
+        for (const T& b : biases.data) out << b << " ";
+        out << "\n";
+    }
+
+    void load(std::istream& in) {
+        in >> in_c_ >> in_h_ >> in_w_ >> out_c_ >> k_ >> stride_ >> pad_;
+        if (!in) throw std::runtime_error("Corrupt Conv2D layer");
+        set_geometry();
+        weights = algebra::Tensor<T, 2>(in_c_ * k_ * k_, out_c_);
+        biases = algebra::Tensor<T, 2>(1, out_c_);
+        for (auto& w : weights) in >> w;
+        for (auto& b : biases) in >> b;
+        if (!in) throw std::runtime_error("Corrupt Conv2D layer");
+        grad_w = algebra::Tensor<T, 2>(in_c_ * k_ * k_, out_c_);
+        grad_b = algebra::Tensor<T, 2>(1, out_c_);
+    }
+
+    size_t input_size() const noexcept { return in_c_ * in_h_ * in_w_; }
+    size_t output_size() const noexcept { return out_c_ * out_h_ * out_w_; }
+    size_t in_channels() const noexcept { return in_c_; }
+    size_t out_channels() const noexcept { return out_c_; }
+    size_t kernel() const noexcept { return k_; }
+    size_t out_height() const noexcept { return out_h_; }
+    size_t out_width() const noexcept { return out_w_; }
+
+    // Multiplicaciones-sumas por muestra.
+    size_t macs() const noexcept { return out_h_ * out_w_ * in_c_ * k_ * k_ * out_c_; }
+};
+
+// Geometría común de los pooling: ventanas de `kernel` con paso `stride`,
+// sin relleno, canal por canal.
+struct PoolGeometry {
+    size_t channels = 0, height = 0, width = 0, kernel = 2, stride = 2;
+    size_t out_h = 0, out_w = 0;
+
+    PoolGeometry() = default;
+    PoolGeometry(size_t channels, size_t height, size_t width, size_t kernel, size_t stride)
+        : channels(channels), height(height), width(width), kernel(kernel), stride(stride) {
+        finish();
+    }
+
+    void finish() {
+        if (kernel == 0 || stride == 0 || height < kernel || width < kernel) {
+            throw std::runtime_error("Invalid pooling geometry");
+        }
+        out_h = (height - kernel) / stride + 1;
+        out_w = (width - kernel) / stride + 1;
+    }
+
+    size_t input_size() const noexcept { return channels * height * width; }
+    size_t output_size() const noexcept { return channels * out_h * out_w; }
+
+    void check(size_t cols) const {
+        if (cols != input_size()) throw std::runtime_error("Pooling input size does not match its geometry");
+    }
+
+    void save(std::ostream& out) const {
+        out << channels << " " << height << " " << width << " " << kernel << " " << stride << "\n";
+    }
+
+    void load(std::istream& in) {
+        in >> channels >> height >> width >> kernel >> stride;
+        if (!in) throw std::runtime_error("Corrupt pooling layer");
+        finish();
+    }
+};
+
+template<typename T>
+class MaxPool2D final : public ILayer<T> {
+private:
+    PoolGeometry g_;
+    std::vector<uint32_t> argmax_;   // índice de entrada ganador por salida
+    size_t rows_ = 0;
+
+    // Recorre las salidas; `emit(salida, índice de entrada ganador)`.
+    template<typename Emit>
+    void pool(const algebra::Tensor<T, 2>& x, Emit emit) const {
+        g_.check(x.shape()[1]);
+        const size_t n = x.shape()[0];
+        for (size_t s = 0; s < n; ++s) {
+            const T* image = x.data.data() + s * g_.input_size();
+            size_t o = s * g_.output_size();
+            for (size_t c = 0; c < g_.channels; ++c)
+                for (size_t oy = 0; oy < g_.out_h; ++oy)
+                    for (size_t ox = 0; ox < g_.out_w; ++ox, ++o) {
+                        size_t best = (c * g_.height + oy * g_.stride) * g_.width + ox * g_.stride;
+                        for (size_t ky = 0; ky < g_.kernel; ++ky)
+                            for (size_t kx = 0; kx < g_.kernel; ++kx) {
+                                const size_t i = (c * g_.height + oy * g_.stride + ky) * g_.width + ox * g_.stride + kx;
+                                if (image[i] > image[best]) best = i;
+                            }
+                        emit(o, image[best], best);
+                    }
+        }
+    }
+
+public:
+    MaxPool2D() = default;
+    MaxPool2D(size_t channels, size_t height, size_t width, size_t kernel = 2, size_t stride = 2)
+        : g_(channels, height, width, kernel, stride) {}
+
+    algebra::Tensor<T, 2> forward(const algebra::Tensor<T, 2>& x) override {
+        rows_ = x.shape()[0];
+        argmax_.resize(rows_ * g_.output_size());
+        algebra::Tensor<T, 2> out(rows_, g_.output_size());
+        pool(x, [&](size_t o, T v, size_t i) { out.data[o] = v; argmax_[o] = static_cast<uint32_t>(i); });
+        return out;
+    }
+
+    algebra::Tensor<T, 2> infer(const algebra::Tensor<T, 2>& x) const override {
+        algebra::Tensor<T, 2> out(x.shape()[0], g_.output_size());
+        pool(x, [&](size_t o, T v, size_t) { out.data[o] = v; });
+        return out;
+    }
+
+    algebra::Tensor<T, 2> backward(const algebra::Tensor<T, 2>& dZ) override {
+        algebra::Tensor<T, 2> dX(rows_, g_.input_size());
+        for (size_t s = 0; s < rows_; ++s)
+            for (size_t o = 0; o < g_.output_size(); ++o)
+                dX.data[s * g_.input_size() + argmax_[s * g_.output_size() + o]] += dZ.data[s * g_.output_size() + o];
+        return dX;
+    }
+
+    void clear_cache() override {
+        argmax_.clear();
+        argmax_.shrink_to_fit();
+    }
+
+    const PoolGeometry& geometry() const noexcept { return g_; }
+    void save(std::ostream& out) const { g_.save(out); }
+    void load(std::istream& in) { g_.load(in); }
+};
+
+template<typename T>
+class AvgPool2D final : public ILayer<T> {
+private:
+    PoolGeometry g_;
+    size_t rows_ = 0;
+
+public:
+    AvgPool2D() = default;
+    AvgPool2D(size_t channels, size_t height, size_t width, size_t kernel = 2, size_t stride = 2)
+        : g_(channels, height, width, kernel, stride) {}
+
+    algebra::Tensor<T, 2> forward(const algebra::Tensor<T, 2>& x) override {
+        rows_ = x.shape()[0];
+        return infer(x);
+    }
+
+    algebra::Tensor<T, 2> infer(const algebra::Tensor<T, 2>& x) const override {
+        g_.check(x.shape()[1]);
+        const size_t n = x.shape()[0];
+        const T scale = T(1) / T(g_.kernel * g_.kernel);
+        algebra::Tensor<T, 2> out(n, g_.output_size());
+        for (size_t s = 0; s < n; ++s) {
+            const T* image = x.data.data() + s * g_.input_size();
+            T* o = out.data.data() + s * g_.output_size();
+            for (size_t c = 0; c < g_.channels; ++c)
+                for (size_t oy = 0; oy < g_.out_h; ++oy)
+                    for (size_t ox = 0; ox < g_.out_w; ++ox) {
+                        T sum = T(0);
+                        for (size_t ky = 0; ky < g_.kernel; ++ky)
+                            for (size_t kx = 0; kx < g_.kernel; ++kx)
+                                sum += image[(c * g_.height + oy * g_.stride + ky) * g_.width + ox * g_.stride + kx];
+                        *o++ = sum * scale;
+                    }
+        }
+        return out;
+    }
+
+    algebra::Tensor<T, 2> backward(const algebra::Tensor<T, 2>& dZ) override {
+        const T scale = T(1) / T(g_.kernel * g_.kernel);
+        algebra::Tensor<T, 2> dX(rows_, g_.input_size());
+        for (size_t s = 0; s < rows_; ++s) {
+            T* image = dX.data.data() + s * g_.input_size();
+            const T* d = dZ.data.data() + s * g_.output_size();
+            for (size_t c = 0; c < g_.channels; ++c)
+                for (size_t oy = 0; oy < g_.out_h; ++oy)
+                    for (size_t ox = 0; ox < g_.out_w; ++ox) {
+                        const T g = *d++ * scale;
+                        for (size_t ky = 0; ky < g_.kernel; ++ky)
+                            for (size_t kx = 0; kx < g_.kernel; ++kx)
+                                image[(c * g_.height + oy * g_.stride + ky) * g_.width + ox * g_.stride + kx] += g;
+                    }
+        }
+        return dX;
+    }
+
+    const PoolGeometry& geometry() const noexcept { return g_; }
+    void save(std::ostream& out) const { g_.save(out); }
+    void load(std::istream& in) { g_.load(in); }
+};
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_CONV_H
@@ -7,6 +7,8 @@
 
 #include "nn_interfaces.h"
 #include "../algebra/tensor.h"
+#include <memory>
+#include <algorithm>
 
 namespace utec {
 namespace neural_network {
@@ -19,6 +21,26 @@ private:
     utec::algebra::Tensor<T, 2> input;
     utec::algebra::Tensor<T, 2> grad_w;
     utec::algebra::Tensor<T, 2> grad_b;
+    bool accumulate_ = false;
+
+    // Pesos de solo lectura referenciados en el lugar (p. ej. dentro de un
+    // archivo mapeado). `backing_` mantiene viva la memoria apuntada.
+    std::shared_ptr<const void> backing_;
+    const T* w_view_ = nullptr;
+    const T* b_view_ = nullptr;
+
+    // Copia la vista a tensores propios antes de modificar los pesos.
+    void materialize() {
+        if (!w_view_) return;
+        assign(w_view_, weights.shape()[0], weights.shape()[1], b_view_);
+    }
+
+    // Tensor con forma pero sin almacenamiento (solo para vistas).
+    static utec::algebra::Tensor<T, 2> shape_only(size_t rows, size_t cols) {
+        utec::algebra::Tensor<T, 2> t(0, 0);
+        t.shape_ = {rows, cols};
+        return t;
+    }
 
 public:
     template<typename InitWFun, typename InitBFun>
@@ -34,36 +56,83 @@ public:
 
     utec::algebra::Tensor<T, 2> forward(const utec::algebra::Tensor<T, 2>& x) override {
         input = x;
+        return infer(x);
+    }
+
+    utec::algebra::Tensor<T, 2> infer(const utec::algebra::Tensor<T, 2>& x) const override {
+        if (w_view_) {
+            const size_t rows = x.shape()[0], in_f = x.shape()[1], out_f = weights.shape()[1];
+            if (in_f != weights.shape()[0]) {
+                throw std::runtime_error("Matrix dimensions are incompatible for multiplication");
+            }
+            utec::algebra::Tensor<T, 2> out(rows, out_f);
+            std::vector<T> acc(out_f);
+            for (size_t i = 0; i < rows; ++i) {
+                std::fill(acc.begin(), acc.end(), T());
+                for (size_t k = 0; k < in_f; ++k) {
+                    const T a = x(i, k);
+                    const T* w_row = w_view_ + k * out_f;
+                    for (size_t j = 0; j < out_f; ++j)
+                        acc[j] += a * w_row[j];
+                }
+                for (size_t j = 0; j < out_f; ++j)
+                    out(i, j) = acc[j] + b_view_[j];
+            }
+            return out;
+        }
         auto out = utec::algebra::matrix_product(x, weights);
         return out + biases;
     }
 
     utec::algebra::Tensor<T, 2> backward(const utec::algebra::Tensor<T, 2>& dZ) override {
-        grad_w = utec::algebra::matrix_product(utec::algebra::transpose_2d(input), dZ);
-        grad_b = utec::algebra::Tensor<T, 2>(1, dZ.shape()[1]);
+        materialize();
+        // Los gradientes se escriben en el lugar; sin acumular se parte de cero.
+        if (grad_w.shape() != weights.shape() || grad_b.shape() != biases.shape()) {
+            grad_w = utec::algebra::Tensor<T, 2>(weights.shape()[0], weights.shape()[1]);
+            grad_b = utec::algebra::Tensor<T, 2>(1, biases.shape()[1]);
+        } else if (!accumulate_) {
+            grad_w.fill(T(0));
+            grad_b.fill(T(0));
+        }
+        utec::algebra::accumulate_transposed_product(grad_w, input, dZ);
         for (size_t j = 0; j < dZ.shape()[1]; ++j) {
             T sum = T(0);
             for (size_t i = 0; i < dZ.shape()[0]; ++i) {
                 sum += dZ(i, j);
             }
-            grad_b(0, j) = sum;
+            grad_b(0, j) += sum;
         }
         return utec::algebra::matrix_product(dZ, utec::algebra::transpose_2d(weights));
     }
 
+    void clear_cache() override {
+        input = utec::algebra::Tensor<T, 2>(0, 0);
+    }
+
+    void set_accumulate_gradients(bool accumulate) override {
+        accumulate_ = accumulate;
+    }
+
     void update_params(IOptimizer<T>& optimizer) override {
-        optimizer.update(weights, grad_w);
-        optimizer.update(biases, grad_b);
-        optimizer.step();
+        materialize();
+        optimizer.update(weights, grad_w, ParamKind::Weight);
+        optimizer.update(biases, grad_b, ParamKind::Bias);
+    }
+
+    std::vector<utec::algebra::Tensor<T, 2>*> parameters() override {
+        materialize();
+        return {&weights, &biases};
     }
 
     void save(std::ostream& out) const {
+        const T* w = weights_data();
+        const T* b = biases_data();
         size_t rows = weights.shape()[0];
         size_t cols = weights.shape()[1];
         out << rows << " " << cols << "\n";
         for (size_t i = 0; i < rows; ++i)
             for (size_t j = 0; j < cols; ++j)
-                out << weights(i,j) << " ";
+                out << w[i * cols + j] << " ";
         out << "\n";
 
         rows = biases.shape()[0];
@@ -71,11 +140,13 @@ public:
         out << rows << " " << cols << "\n";
         for (size_t i = 0; i < rows; ++i)
             for (size_t j = 0; j < cols; ++j)
-                out << biases(i,j) << " ";
+                out << b[i * cols + j] << " ";
         out << "\n";
     }
 
     void load(std::istream& in) {
+        w_view_ = b_view_ = nullptr;
+        backing_.reset();
         size_t rows, cols;
 
         in >> rows >> cols;
@@ -93,6 +164,38 @@ public:
             for (size_t j = 0; j < cols; ++j)
                 in >> biases(i,j);
     }
+
+    // Copia pesos (in_f x out_f) y sesgos (1 x out_f) desde memoria cruda.
+    void assign(const T* w, size_t in_f, size_t out_f, const T* b) {
+        utec::algebra::Tensor<T, 2> new_w(in_f, out_f);
+        utec::algebra::Tensor<T, 2> new_b(1, out_f);
+        std::copy(w, w + in_f * out_f, new_w.begin());
+        std::copy(b, b + out_f, new_b.begin());
+        weights = std::move(new_w);
+        biases = std::move(new_b);
+        grad_w = utec::algebra::Tensor<T, 2>(in_f, out_f);
+        grad_b = utec::algebra::Tensor<T, 2>(1, out_f);
+        w_view_ = b_view_ = nullptr;
+        backing_.reset();
+    }
+
+    // Referencia pesos externos sin copiarlos; los tensores propios solo
+    // guardan la forma hasta que un backward/update fuerce la copia.
+    void bind(std::shared_ptr<const void> backing, const T* w, size_t in_f, size_t out_f, const T* b) {
+        backing_ = std::move(backing);
+        w_view_ = w;
+        b_view_ = b;
+        weights = shape_only(in_f, out_f);
+        biases = shape_only(1, out_f);
+        grad_w = shape_only(in_f, out_f);
+        grad_b = shape_only(1, out_f);
+    }
+
+    bool is_view() const noexcept { return w_view_ != nullptr; }
+    size_t in_features() const noexcept { return weights.shape()[0]; }
+    size_t out_features() const noexcept { return weights.shape()[1]; }
+    const T* weights_data() const noexcept { return w_view_ ? w_view_ : weights.data.data(); }
+    const T* biases_data() const noexcept { return b_view_ ? b_view_ : biases.data.data(); }
 };
 
 } // namespace neural_network
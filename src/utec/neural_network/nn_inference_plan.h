@@ -0,0 +1,247 @@
+//
+// Plan de inferencia: los pesos de cada Dense se empaquetan una sola vez al
+// construir el plan y predict recorre los pasos sin revalidar formas.
+//
+// Empaquetado por paneles de NR columnas de salida: el panel p guarda, para
+// cada entrada k, los NR pesos W[k][p*NR .. p*NR+NR) contiguos, y al final la
+// fila de sesgos. El micro-kernel recorre el panel secuencialmente y mantiene
+// MR x NR acumuladores en registros.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_INFERENCE_PLAN_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_INFERENCE_PLAN_H
+
+#include "nn_interfaces.h"
+#include "nn_dense.h"
+#include "nn_activation.h"
+#include "../algebra/simd.h"
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace utec::neural_network {
+
+// Estado de una llamada de inferencia (buffers intermedios). Cada hilo usa
+// el suyo; el plan y la red solo se leen.
+template<typename T>
+struct InferenceContext {
+    std::vector<T> ping, pong, acc;
+};
+
+template<typename T>
+class InferencePlan {
+public:
+    static constexpr size_t NR = 16;
+    static constexpr size_t MR = algebra::simd::PANEL_ROWS;
+
+private:
+    enum class Activation { None, ReLU, Sigmoid };
+
+    struct Step {
+        // Dense empaquetado; si `layer` no es nulo, el paso delega en él.
+        size_t in_f = 0, out_f = 0;
+        std::vector<T> packed;
+        Activation activation = Activation::None;
+        const ILayer<T>* layer = nullptr;
+    };
+
+    std::vector<Step> steps_;
+    size_t input_size_ = 0;
+    size_t max_width_ = 0;      // ancho máximo con relleno de paneles
+    bool dense_only_ = true;    // sin pasos que deleguen en forward
+
+    static std::vector<T> pack(const Dense<T>& dense) {
+        const size_t in_f = dense.in_features(), out_f = dense.out_features();
+        const size_t panels = (out_f + NR - 1) / NR;
+        const T* w = dense.weights_data();
+        const T* b = dense.biases_data();
+        std::vector<T> packed(panels * (in_f + 1) * NR, T(0));
+        for (size_t p = 0; p < panels; ++p) {
+            T* panel = &packed[p * (in_f + 1) * NR];
+            const size_t cols = std::min(NR, out_f - p * NR);
+            for (size_t k = 0; k < in_f; ++k)
+                std::copy_n(w + k * out_f + p * NR, cols, panel + k * NR);
+            std::copy_n(b + p * NR, cols, panel + in_f * NR);
+        }
+        return packed;
+    }
+
+    static T activate(T v, Activation activation) {
+        switch (activation) {
+        case Activation::ReLU: return std::max(T(0), v);
+        case Activation::Sigmoid: return T(1) / (T(1) + std::exp(-v));
+        default: return v;
+        }
+    }
+
+    // R filas de x contra un panel. Misma secuencia de sumas que
+    // matrix_product seguido del sesgo, así que el resultado coincide.
+    template<size_t R>
+    static void micro_kernel(const T* x, size_t in_f, const T* panel, size_t cols,
+                             T* y, size_t out_f, Activation activation) {
+        T acc[R][NR] = {};
+        if constexpr (std::is_same_v<T, float>) {
+            algebra::simd::gemm_panel16<R>(x, in_f, panel, in_f, &acc[0][0]);
+        } else {
+            for (size_t k = 0; k < in_f; ++k) {
+                const T* w = panel + k * NR;
+                for (size_t r = 0; r < R; ++r) {
+                    const T a = x[r * in_f + k];
+                    for (size_t c = 0; c < NR; ++c)
+                        acc[r][c] += a * w[c];
+                }
+            }
+        }
+        const T* bias = panel + in_f * NR;
+        for (size_t r = 0; r < R; ++r)
+            for (size_t c = 0; c < cols; ++c)
+                y[r * out_f + c] = activate(acc[r][c] + bias[c], activation);
+    }
+
+    // Una fila: GEMV sobre todos los paneles y luego sesgo + activación.
+    static void run_dense_one(const Step& step, const T* x, T* y, T* acc) {
+        const size_t panels = (step.out_f + NR - 1) / NR;
+        const size_t panel_size = (step.in_f + 1) * NR;
+        if constexpr (std::is_same_v<T, float>) {
+            algebra::simd::gemv_panels16(x, step.packed.data(), panel_size, panels, step.in_f, acc);
+            for (size_t p = 0; p < panels; ++p) {
+                const T* bias = &step.packed[p * panel_size + step.in_f * NR];
+                const size_t cols = std::min(NR, step.out_f - p * NR);
+                for (size_t c = 0; c < cols; ++c)
+                    y[p * NR + c] = activate(acc[p * NR + c] + bias[c], step.activation);
+            }
+        } else {
+            for (size_t p = 0; p < panels; ++p)
+                micro_kernel<1>(x, step.in_f, &step.packed[p * panel_size], std::min(NR, step.out_f - p * NR),
+                                y + p * NR, step.out_f, step.activation);
+        }
+    }
+
+    static void run_dense(const Step& step, const T* x, size_t rows, T* y) {
+        const size_t panels = (step.out_f + NR - 1) / NR;
+        const size_t panel_size = (step.in_f + 1) * NR;
+        size_t i = 0;
+        for (; i + MR <= rows; i += MR)
+            for (size_t p = 0; p < panels; ++p)
+                micro_kernel<MR>(x + i * step.in_f, step.in_f, &step.packed[p * panel_size],
+                                 std::min(NR, step.out_f - p * NR), y + i * step.out_f + p * NR,
+                                 step.out_f, step.activation);
+        for (; i < rows; ++i)
+            for (size_t p = 0; p < panels; ++p)
+                micro_kernel<1>(x + i * step.in_f, step.in_f, &step.packed[p * panel_size],
+                                std::min(NR, step.out_f - p * NR), y + i * step.out_f + p * NR,
+                                step.out_f, step.activation);
+    }
+
+public:
+    // Las capas que no sean Dense/ReLU/Sigmoid se ejecutan con su infer; el
+    // plan guarda punteros a ellas, así que vale mientras la red no cambie.
+    // Todo lo que hace el plan es const: es seguro usarlo desde varios hilos.
+    explicit InferencePlan(const std::vector<std::unique_ptr<ILayer<T>>>& layers) {
+        size_t width = 0;
+        for (const auto& layer : layers) {
+            const ILayer<T>* ptr = layer.get();
+            Activation activation = Activation::None;
+            if (dynamic_cast<const ReLU<T>*>(ptr)) activation = Activation::ReLU;
+            else if (dynamic_cast<const Sigmoid<T>*>(ptr)) activation = Activation::Sigmoid;
+
+            if (auto dense = dynamic_cast<const Dense<T>*>(ptr)) {
+                if (!steps_.empty() && width != 0 && dense->in_features() != width) {
+                    throw std::runtime_error("Incompatible layer sizes in inference plan");
+                }
+                if (steps_.empty()) input_size_ = dense->in_features();
+                Step step;
+                step.in_f = dense->in_features();
+                step.out_f = width = dense->out_features();
+                step.packed = pack(*dense);
+                max_width_ = std::max({max_width_, step.in_f, (step.out_f + NR - 1) / NR * NR});
+                steps_.push_back(std::move(step));
+            } else if (activation != Activation::None && !steps_.empty() && !steps_.back().layer
+                       && steps_.back().activation == Activation::None) {
+                // Se fusiona en la salida del Dense anterior.
+                steps_.back().activation = activation;
+            } else {
+                Step step;
+                step.layer = ptr;
+                steps_.push_back(std::move(step));
+                width = 0;
+                dense_only_ = false;
+            }
+        }
+    }
+
+    algebra::Tensor<T, 2> run(const algebra::Tensor<T, 2>& X) const {
+        if (input_size_ != 0 && X.shape()[1] != input_size_) {
+            throw std::runtime_error("Input size does not match the inference plan");
+        }
+        const size_t rows = X.shape()[0];
+        const algebra::Tensor<T, 2>* src = &X;
+        algebra::Tensor<T, 2> current(0, 0);
+        for (const Step& step : steps_) {
+            if (step.layer) {
+                current = step.layer->infer(*src);
+            } else {
+                algebra::Tensor<T, 2> out(rows, step.out_f);
+                run_dense(step, src->data.data(), rows, out.data.data());
+                current = std::move(out);
+            }
+            src = &current;
+        }
+        return src == &X ? X : current;
+    }
+
+    // Una muestra: x con input_size() valores, y con output_size(). Si el plan
+    // es solo Dense/ReLU/Sigmoid no reserva memoria: usa los buffers del
+    // contexto, que crecen una única vez. Si no, pasa por run().
+    void run_one(const T* x, T* y, InferenceContext<T>& context) const {
+        if (input_size_ == 0) {
+            throw std::runtime_error("Inference plan does not start with a Dense layer");
+        }
+        if (!dense_only_) {
+            algebra::Tensor<T, 2> in(1, input_size_);
+            std::copy(x, x + input_size_, in.begin());
+            auto out = run(in);
+            std::copy(out.cbegin(), out.cend(), y);
+            return;
+        }
+        auto& [ping, pong, acc] = context;
+        if (acc.size() < max_width_) {
+            ping.resize(max_width_);
+            pong.resize(max_width_);
+            acc.resize(max_width_);
+        }
+        const T* src = x;
+        for (size_t s = 0; s < steps_.size(); ++s) {
+            T* dst = s + 1 == steps_.size() ? y : (src == ping.data() ? pong.data() : ping.data());
+            run_dense_one(steps_[s], src, dst, acc.data());
+            src = dst;
+        }
+    }
+
+    // Con un contexto propio de cada hilo.
+    void run_one(const T* x, T* y) const {
+        thread_local InferenceContext<T> context;
+        run_one(x, y, context);
+    }
+
+    size_t input_size() const noexcept { return input_size_; }
+
+    // Ancho de la salida; 0 si el último paso delega en forward.
+    size_t output_size() const noexcept {
+        return steps_.empty() || steps_.back().layer ? 0 : steps_.back().out_f;
+    }
+
+    // Bytes de pesos empaquetados (incluye relleno de paneles y sesgos).
+    size_t packed_bytes() const {
+        size_t total = 0;
+        for (const auto& step : steps_) total += step.packed.size() * sizeof(T);
+        return total;
+    }
+};
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_INFERENCE_PLAN_H
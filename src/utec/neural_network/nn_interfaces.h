@@ -6,16 +6,36 @@
 #define PROG3_NN_FINAL_PROJECT_V2025_01_LAYER_H
 
 #include "../algebra/tensor.h"
+#include <iostream>
+#include <vector>
+#include <stdexcept>
 
 namespace utec::neural_network {
 
+  // Qué es cada tensor que una capa pasa al optimizador. Bias incluye los
+  // sesgos y gamma/beta de BatchNorm: LARS y LAMB no les aplican tasa por
+  // capa ni weight decay.
+  enum class ParamKind { Weight, Bias };
+
   // Interfaz del optimizador (SGD o Adam)
   template<typename T>
   struct IOptimizer {
     virtual ~IOptimizer() = default;
     virtual void update(utec::algebra::Tensor<T,2>& params, 
                         const utec::algebra::Tensor<T,2>& gradients) = 0;
+    // Las capas llaman a esta versión; solo la redefinen los optimizadores
+    // que tratan distinto a los sesgos.
+    virtual void update(utec::algebra::Tensor<T,2>& params,
+                        const utec::algebra::Tensor<T,2>& gradients, ParamKind) {
+        update(params, gradients);
+    }
+    // Se llama una vez por batch, después de actualizar todas las capas
     virtual void step() {}
+    virtual void set_learning_rate(T /*learning_rate*/) {}
+
+    // Estado interno (momentos, contador de pasos) para checkpoints
+    virtual void save_state(std::ostream& /*out*/) const {}
+    virtual void load_state(std::istream& /*in*/) {}
   };
 
   // Interfaz de las capas (Dense y los diferentes tipos de activación)
@@ -29,9 +49,29 @@ namespace utec::neural_network {
     virtual utec::algebra::Tensor<T,2> backward(
         const utec::algebra::Tensor<T,2>& gradients) = 0;
 
+    // Forward de solo inferencia: no guarda nada para backward, así que
+    // varios hilos pueden llamarlo a la vez sobre la misma capa
+    virtual utec::algebra::Tensor<T,2> infer(const utec::algebra::Tensor<T,2>& /*x*/) const {
+        throw std::runtime_error("Layer does not support const inference");
+    }
+
     // Se utiliza para actualizar los parameters a través del optimizador
     // Se puede llamar tanto el método update y step si es requerido
     virtual void update_params(IOptimizer<T>& optimizer) {}
+
+    // Parámetros entrenables de la capa (para checkpoints); vacío si no tiene
+    virtual std::vector<utec::algebra::Tensor<T,2>*> parameters() { return {}; }
+
+    // Estado no entrenable que igual hay que guardar (estadísticas móviles)
+    virtual std::vector<utec::algebra::Tensor<T,2>*> buffers() { return {}; }
+
+    // Con accumulate, backward suma a los gradientes que ya tiene en vez de
+    // reemplazarlos (micro-batches de un mismo paso del optimizador)
+    virtual void set_accumulate_gradients(bool /*accumulate*/) {}
+
+    // Libera lo que forward guardó para backward (checkpointing de
+    // activaciones: se vuelve a calcular con otro forward antes del backward)
+    virtual void clear_cache() {}
   };
 
   // Interfaz de las pérdidas (MSE o BCE)
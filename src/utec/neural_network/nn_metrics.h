@@ -0,0 +1,217 @@
+//
+// Métricas de clasificación y evaluación por bloques.
+//
+// ClassificationMetrics acumula exactitud, top-k y matriz de confusión; dos
+// acumuladores se combinan con merge, así cada hilo lleva el suyo. evaluate
+// corre predict bloque a bloque en el hilo que llama mientras los workers
+// acumulan los bloques ya predichos: nunca se arma la matriz de predicciones
+// completa y el tiempo total queda dominado por el forward.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_METRICS_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_METRICS_H
+
+#include "../algebra/tensor.h"
+#include "../algebra/simd.h"
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace utec::neural_network {
+
+class ClassificationMetrics {
+private:
+    size_t classes_;
+    size_t top_k_;
+    std::vector<uint64_t> confusion_; // fila: clase real, columna: predicha
+    uint64_t total_ = 0;
+    uint64_t correct_ = 0;
+    uint64_t top_k_hits_ = 0;
+
+    template<typename T>
+    static size_t argmax(const T* scores, size_t n) {
+        if constexpr (std::is_same_v<T, float>) {
+            return algebra::simd::argmax(scores, n);
+        } else {
+            size_t best = 0;
+            for (size_t j = 1; j < n; ++j)
+                if (scores[j] > scores[best]) best = j;
+            return best;
+        }
+    }
+
+public:
+    explicit ClassificationMetrics(size_t classes, size_t top_k = 1)
+        : classes_(classes), top_k_(std::max<size_t>(top_k, 1)), confusion_(classes * classes, 0) {}
+
+    // scores: rows x classes (fila contigua por muestra).
+    template<typename T>
+    void add(const T* scores, size_t rows, const int* labels) {
+        for (size_t r = 0; r < rows; ++r) {
+            const T* row = scores + r * classes_;
+            const int label = labels[r];
+            if (label < 0 || static_cast<size_t>(label) >= classes_) {
+                throw std::runtime_error("Label out of range in metrics");
+            }
+            const size_t predicted = argmax(row, classes_);
+            ++confusion_[static_cast<size_t>(label) * classes_ + predicted];
+            ++total_;
+            correct_ += predicted == static_cast<size_t>(label);
+
+            // Posición de la clase real en el orden de argmax (empates por índice).
+            size_t rank = 0;
+            const T target = row[label];
+            for (size_t j = 0; j < classes_ && rank < top_k_; ++j)
+                rank += row[j] > target || (row[j] == target && j < static_cast<size_t>(label));
+            top_k_hits_ += rank < top_k_;
+        }
+    }
+
+    void merge(const ClassificationMetrics& other) {
+        if (other.classes_ != classes_ || other.top_k_ != top_k_) {
+            throw std::runtime_error("Cannot merge metrics with different shapes");
+        }
+        for (size_t i = 0; i < confusion_.size(); ++i) confusion_[i] += other.confusion_[i];
+        total_ += other.total_;
+        correct_ += other.correct_;
+        top_k_hits_ += other.top_k_hits_;
+    }
+
+    size_t classes() const noexcept { return classes_; }
+    size_t top_k() const noexcept { return top_k_; }
+    uint64_t total() const noexcept { return total_; }
+    uint64_t correct() const noexcept { return correct_; }
+    uint64_t confusion(size_t actual, size_t predicted) const { return confusion_[actual * classes_ + predicted]; }
+
+    double accuracy() const noexcept { return total_ ? double(correct_) / double(total_) : 0.0; }
+    double top_k_accuracy() const noexcept { return total_ ? double(top_k_hits_) / double(total_) : 0.0; }
+
+    double precision(size_t c) const {
+        uint64_t predicted = 0;
+        for (size_t a = 0; a < classes_; ++a) predicted += confusion(a, c);
+        return predicted ? double(confusion(c, c)) / double(predicted) : 0.0;
+    }
+
+    double recall(size_t c) const {
+        uint64_t actual = 0;
+        for (size_t p = 0; p < classes_; ++p) actual += confusion(c, p);
+        return actual ? double(confusion(c, c)) / double(actual) : 0.0;
+    }
+
+    void print(std::ostream& out) const {
+        out << std::fixed << std::setprecision(2);
+        out << "Exactitud: " << accuracy() * 100 << " % (" << correct_ << "/" << total_ << ")\n";
+        if (top_k_ > 1) out << "Top-" << top_k_ << ": " << top_k_accuracy() * 100 << " %\n";
+        out << "Clase  Precision  Recall\n";
+        for (size_t c = 0; c < classes_; ++c)
+            out << std::setw(5) << c << std::setw(10) << precision(c) * 100 << " %"
+                << std::setw(7) << recall(c) * 100 << " %\n";
+        out << "Matriz de confusion (fila: real, columna: predicha)\n";
+        for (size_t a = 0; a < classes_; ++a) {
+            for (size_t p = 0; p < classes_; ++p) out << std::setw(6) << confusion(a, p);
+            out << "\n";
+        }
+        out << std::defaultfloat << std::setprecision(6);
+    }
+};
+
+struct EvaluationOptions {
+    size_t chunk_size = 1024;
+    size_t workers = 2;
+    size_t top_k = 5;
+};
+
+// `model` es cualquier cosa con predict(Tensor) -> Tensor (NeuralNetwork,
+// QuantizedNetwork, ...). labels[i] es la clase real de la fila i de X.
+template<typename Model, typename T>
+ClassificationMetrics evaluate(Model& model, const algebra::Tensor<T, 2>& X, const std::vector<int>& labels,
+                               size_t num_classes, const EvaluationOptions& options = {}) {
+    const size_t rows = X.shape()[0], cols = X.shape()[1];
+    if (labels.size() != rows) {
+        throw std::runtime_error("Labels do not match the number of samples");
+    }
+    const size_t chunk = std::max<size_t>(options.chunk_size, 1);
+    const size_t workers = std::max<size_t>(options.workers, 1);
+
+    struct Block {
+        algebra::Tensor<T, 2> scores;
+        size_t first;
+    };
+    std::deque<Block> queue;
+    bool done = false;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable ready, space;
+
+    std::vector<ClassificationMetrics> partial(workers, ClassificationMetrics(num_classes, options.top_k));
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&, w] {
+            while (true) {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [&] { return done || !queue.empty(); });
+                if (queue.empty()) return;
+                Block block = std::move(queue.front());
+                queue.pop_front();
+                lock.unlock();
+                space.notify_one();
+                try {
+                    if (block.scores.shape()[1] != num_classes) {
+                        throw std::runtime_error("Model output does not match the number of classes");
+                    }
+                    partial[w].add(block.scores.data.data(), block.scores.shape()[0], &labels[block.first]);
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(mutex);
+                    if (!error) error = std::current_exception();
+                }
+            }
+        });
+    }
+
+    auto finish = [&] {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+        }
+        ready.notify_all();
+        for (auto& t : threads) t.join();
+    };
+
+    try {
+        for (size_t first = 0; first < rows; first += chunk) {
+            const size_t n = std::min(chunk, rows - first);
+            algebra::Tensor<T, 2> x(n, cols);
+            std::copy(X.cbegin() + first * cols, X.cbegin() + (first + n) * cols, x.begin());
+            Block block{model.predict(x), first};
+
+            std::unique_lock<std::mutex> lock(mutex);
+            space.wait(lock, [&] { return queue.size() < 2 * workers || error; });
+            if (error) break;
+            queue.push_back(std::move(block));
+            lock.unlock();
+            ready.notify_one();
+        }
+    } catch (...) {
+        finish();
+        throw;
+    }
+    finish();
+    if (error) std::rethrow_exception(error);
+
+    ClassificationMetrics total(num_classes, options.top_k);
+    for (const auto& p : partial) total.merge(p);
+    return total;
+}
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_METRICS_H
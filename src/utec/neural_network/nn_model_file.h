@@ -0,0 +1,256 @@
+//
+// Formato binario de modelo (.nnb), versionado y mapeable en memoria.
+//
+//   [Header 64 B][LayerEntry 64 B x layer_count][blobs alineados a 64 B]
+//
+// Cada blob guarda los pesos (in x out) o sesgos (1 x out) de un Dense en el
+// dtype del modelo, little-endian, con su CRC32. Al cargar con in_place los
+// Dense referencian los blobs directamente dentro del mapeo.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_MODEL_FILE_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_MODEL_FILE_H
+
+#include "nn_interfaces.h"
+#include "nn_dense.h"
+#include "nn_activation.h"
+#include "mapped_file.h"
+#include <array>
+#include <vector>
+#include <memory>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <random>
+#include <filesystem>
+
+namespace utec::neural_network {
+
+namespace model_file {
+
+constexpr char MAGIC[4] = {'U', 'T', 'N', 'N'};
+constexpr uint32_t VERSION = 1;
+constexpr uint64_t ALIGNMENT = 64;
+
+enum class LayerType : uint32_t { Dense = 1, ReLU = 2, Sigmoid = 3 };
+enum class DType : uint32_t { Float32 = 1, Float64 = 2 };
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t dtype;
+    uint32_t layer_count;
+    uint64_t table_offset;
+    uint64_t file_size;
+    uint32_t table_checksum;
+    uint8_t reserved[28];
+};
+static_assert(sizeof(Header) == 64, "Header must be 64 bytes");
+
+struct LayerEntry {
+    uint32_t type;
+    uint32_t reserved0;
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t weights_offset;
+    uint64_t biases_offset;
+    uint32_t weights_checksum;
+    uint32_t biases_checksum;
+    uint8_t reserved[16];
+};
+static_assert(sizeof(LayerEntry) == 64, "LayerEntry must be 64 bytes");
+
+inline uint32_t crc32(const void* data, size_t size) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+inline uint64_t align_up(uint64_t value) {
+    return (value + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+template<typename T>
+constexpr DType dtype_of() {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Only float and double models");
+    return std::is_same_v<T, float> ? DType::Float32 : DType::Float64;
+}
+
+inline bool is_model_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[4] = {};
+    in.read(magic, sizeof(magic));
+    return in && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+template<typename T>
+void write(const std::vector<std::unique_ptr<ILayer<T>>>& layers, const std::string& path) {
+    std::vector<LayerEntry> table(layers.size());
+    std::vector<std::pair<const T*, size_t>> blobs;
+    uint64_t offset = align_up(sizeof(Header) + sizeof(LayerEntry) * layers.size());
+
+    for (size_t i = 0; i < layers.size(); ++i) {
+        LayerEntry& entry = table[i];
+        std::memset(&entry, 0, sizeof(entry));
+        const ILayer<T>* layer = layers[i].get();
+        if (auto dense = dynamic_cast<const Dense<T>*>(layer)) {
+            entry.type = static_cast<uint32_t>(LayerType::Dense);
+            entry.rows = dense->in_features();
+            entry.cols = dense->out_features();
+            const size_t w_bytes = entry.rows * entry.cols * sizeof(T);
+            const size_t b_bytes = entry.cols * sizeof(T);
+            entry.weights_offset = offset;
+            entry.weights_checksum = crc32(dense->weights_data(), w_bytes);
+            offset = align_up(offset + w_bytes);
+            entry.biases_offset = offset;
+            entry.biases_checksum = crc32(dense->biases_data(), b_bytes);
+            offset = align_up(offset + b_bytes);
+            blobs.emplace_back(dense->weights_data(), w_bytes);
+            blobs.emplace_back(dense->biases_data(), b_bytes);
+        } else if (dynamic_cast<const ReLU<T>*>(layer)) {
+            entry.type = static_cast<uint32_t>(LayerType::ReLU);
+        } else if (dynamic_cast<const Sigmoid<T>*>(layer)) {
+            entry.type = static_cast<uint32_t>(LayerType::Sigmoid);
+        } else {
+            throw std::runtime_error("Layer type not supported by the binary model format");
+        }
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.dtype = static_cast<uint32_t>(dtype_of<T>());
+    header.layer_count = static_cast<uint32_t>(layers.size());
+    header.table_offset = sizeof(Header);
+    header.file_size = offset;
+    header.table_checksum = crc32(table.data(), sizeof(LayerEntry) * table.size());
+
+    // Se escribe aparte y se renombra: otros procesos pueden tener mapeado el
+    // archivo anterior, y truncarlo en el lugar invalidaría sus páginas.
+    const std::string tmp = path + ".tmp" + std::to_string(std::random_device{}());
+    std::ofstream out(tmp, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Cannot write " + tmp);
+    }
+    const char zeros[ALIGNMENT] = {};
+    uint64_t written = 0;
+    auto pad_to = [&](uint64_t target) {
+        out.write(zeros, static_cast<std::streamsize>(target - written));
+        written = target;
+    };
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(sizeof(LayerEntry) * table.size()));
+    written = sizeof(header) + sizeof(LayerEntry) * table.size();
+    for (const auto& [ptr, bytes] : blobs) {
+        pad_to(align_up(written));
+        out.write(reinterpret_cast<const char*>(ptr), static_cast<std::streamsize>(bytes));
+        written += bytes;
+    }
+    pad_to(offset);
+    out.close();
+    if (!out) {
+        std::filesystem::remove(tmp);
+        throw std::runtime_error("Cannot write " + tmp);
+    }
+    std::filesystem::rename(tmp, path);
+}
+
+// Lee un modelo binario. Con in_place los Dense quedan como vistas sobre el
+// archivo mapeado (que vive mientras alguna capa lo use); si no, se copian.
+// El mapeo se comparte con otras cargas del mismo archivo en el proceso y
+// sus checksums se validan solo la primera vez.
+template<typename T>
+std::vector<std::unique_ptr<ILayer<T>>> read(const std::string& path, bool in_place = true, bool verify = true) {
+    const auto handle = SharedMappings::acquire(path);
+    const auto& file = handle.file;
+    const unsigned char* base = file->data();
+    const bool check = verify && !handle.verified;
+
+    if (file->size() < sizeof(Header)) {
+        throw std::runtime_error("Model file too small: " + path);
+    }
+    Header header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a binary model file: " + path);
+    }
+    if (header.version != VERSION) {
+        throw std::runtime_error("Unsupported model file version " + std::to_string(header.version));
+    }
+    if (header.dtype != static_cast<uint32_t>(dtype_of<T>())) {
+        throw std::runtime_error("Model dtype does not match the network type");
+    }
+    const uint64_t size = file->size();
+    const uint64_t table_bytes = sizeof(LayerEntry) * uint64_t(header.layer_count);
+    if (header.file_size > size || table_bytes > size || header.table_offset > size - table_bytes) {
+        throw std::runtime_error("Truncated model file: " + path);
+    }
+    const auto* table = reinterpret_cast<const LayerEntry*>(base + header.table_offset);
+    if (check && crc32(table, table_bytes) != header.table_checksum) {
+        throw std::runtime_error("Layer table checksum mismatch in " + path);
+    }
+
+    std::vector<std::unique_ptr<ILayer<T>>> layers;
+    for (uint32_t i = 0; i < header.layer_count; ++i) {
+        const LayerEntry& entry = table[i];
+        switch (static_cast<LayerType>(entry.type)) {
+        case LayerType::Dense: {
+            // rows y cols vienen del archivo: se acotan antes de multiplicar
+            // para que el producto no desborde.
+            if (entry.cols > size / sizeof(T) || (entry.cols != 0 && entry.rows > size / entry.cols / sizeof(T))) {
+                throw std::runtime_error("Corrupt layer entry in " + path);
+            }
+            const uint64_t w_bytes = entry.rows * entry.cols * sizeof(T);
+            const uint64_t b_bytes = entry.cols * sizeof(T);
+            if (entry.weights_offset > size - w_bytes || entry.biases_offset > size - b_bytes
+                || entry.weights_offset % ALIGNMENT != 0 || entry.biases_offset % ALIGNMENT != 0) {
+                throw std::runtime_error("Corrupt layer entry in " + path);
+            }
+            const T* w = reinterpret_cast<const T*>(base + entry.weights_offset);
+            const T* b = reinterpret_cast<const T*>(base + entry.biases_offset);
+            if (check && (crc32(w, w_bytes) != entry.weights_checksum || crc32(b, b_bytes) != entry.biases_checksum)) {
+                throw std::runtime_error("Weight checksum mismatch in " + path);
+            }
+            auto dense = std::make_unique<Dense<T>>(0, 0, [](auto&){}, [](auto&){});
+            if (in_place)
+                dense->bind(file, w, entry.rows, entry.cols, b);
+            else
+                dense->assign(w, entry.rows, entry.cols, b);
+            layers.push_back(std::move(dense));
+            break;
+        }
+        case LayerType::ReLU:
+            layers.push_back(std::make_unique<ReLU<T>>());
+            break;
+        case LayerType::Sigmoid:
+            layers.push_back(std::make_unique<Sigmoid<T>>());
+            break;
+        default:
+            throw std::runtime_error("Unknown layer type in " + path);
+        }
+    }
+    if (check) SharedMappings::mark_verified(handle);
+    return layers;
+}
+
+} // namespace model_file
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_MODEL_FILE_H
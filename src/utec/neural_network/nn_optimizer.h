@@ -8,10 +8,75 @@
 #include "nn_interfaces.h"
 #include <vector>
 #include <cmath>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
 
 namespace utec {
 namespace neural_network {
 
+namespace detail {
+
+template<typename V>
+void write_pod(std::ostream& out, const V& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(V));
+}
+
+template<typename V>
+void read_pod(std::istream& in, V& value) {
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(V)))
+        throw std::runtime_error("Unexpected end of optimizer state");
+}
+
+inline void write_tag(std::ostream& out, const std::string& tag) {
+    write_pod(out, static_cast<uint32_t>(tag.size()));
+    out.write(tag.data(), static_cast<std::streamsize>(tag.size()));
+}
+
+inline void expect_tag(std::istream& in, const std::string& tag) {
+    uint32_t size = 0;
+    read_pod(in, size);
+    std::string found(size, '\0');
+    in.read(found.data(), size);
+    if (found != tag)
+        throw std::runtime_error("Optimizer state is for '" + found + "', expected '" + tag + "'");
+}
+
+template<typename T>
+void write_tensors(std::ostream& out, const std::vector<utec::algebra::Tensor<T, 2>>& tensors) {
+    write_pod(out, static_cast<uint64_t>(tensors.size()));
+    for (const auto& t : tensors) {
+        write_pod(out, static_cast<uint64_t>(t.shape()[0]));
+        write_pod(out, static_cast<uint64_t>(t.shape()[1]));
+        out.write(reinterpret_cast<const char*>(t.data.data()), static_cast<std::streamsize>(t.size() * sizeof(T)));
+    }
+}
+
+template<typename T>
+void read_tensors(std::istream& in, std::vector<utec::algebra::Tensor<T, 2>>& tensors) {
+    uint64_t count = 0;
+    read_pod(in, count);
+    tensors.clear();
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t rows = 0, cols = 0;
+        read_pod(in, rows);
+        read_pod(in, cols);
+        tensors.emplace_back(static_cast<size_t>(rows), static_cast<size_t>(cols));
+        if (!in.read(reinterpret_cast<char*>(tensors.back().data.data()),
+                     static_cast<std::streamsize>(tensors.back().size() * sizeof(T))))
+            throw std::runtime_error("Unexpected end of optimizer state");
+    }
+}
+
+template<typename T>
+T squared_norm(const utec::algebra::Tensor<T, 2>& t) {
+    T sum = T(0);
+    for (size_t i = 0; i < t.size(); ++i) sum += t.cbegin()[i] * t.cbegin()[i];
+    return sum;
+}
+
+} // namespace detail
+
 template<typename T>
 class SGD final : public IOptimizer<T> {
 private:
@@ -25,13 +90,27 @@ public:
         for (size_t i = 0; i < params.size(); ++i)
             params.begin()[i] -= l_r * grads.cbegin()[i];
     }
+
+    void set_learning_rate(T learning_rate) override { l_r = learning_rate; }
+
+    void save_state(std::ostream& out) const override {
+        detail::write_tag(out, "SGD");
+    }
+
+    void load_state(std::istream& in) override {
+        detail::expect_tag(in, "SGD");
+    }
 };
 
+// Adam guarda un par de momentos por tensor de parámetros. Los tensores se
+// identifican por el orden de llamada a update() dentro de cada paso; step()
+// cierra el paso.
 template<typename T>
 class Adam final : public IOptimizer<T> {
 private:
     T lr_, beta1_, beta2_, epsilon_;
     size_t t_ = 0;
+    size_t cursor_ = 0;
     std::vector<utec::algebra::Tensor<T, 2>> t1, t2;
 
 public:
@@ -40,29 +119,201 @@ public:
 
     void update(utec::algebra::Tensor<T, 2>& params,
                 const utec::algebra::Tensor<T, 2>& grads) override {
-        if (t1.empty()) {
+        if (cursor_ == 0) t_++;
+        if (cursor_ == t1.size()) {
             t1.emplace_back(grads.shape()[0], grads.shape()[1]);
             t2.emplace_back(grads.shape()[0], grads.shape()[1]);
-            t1[0].fill(T(0));
-            t2[0].fill(T(0));
+            t1.back().fill(T(0));
+            t2.back().fill(T(0));
+        } else if (t1[cursor_].shape() != grads.shape()) {
+            throw std::runtime_error("Adam: parameter shapes changed between steps");
         }
 
-        t_++;
-        auto& T1 = t1[0];
-        auto& T2 = t2[0];
+        auto& T1 = t1[cursor_];
+        auto& T2 = t2[cursor_];
+        cursor_++;
 
+        const T correction1 = 1 - std::pow(beta1_, T(t_));
+        const T correction2 = 1 - std::pow(beta2_, T(t_));
         for (size_t i = 0; i < grads.size(); ++i) {
             T1.begin()[i] = beta1_ * T1.begin()[i] + (1 - beta1_) * grads.cbegin()[i];
             T2.begin()[i] = beta2_ * T2.begin()[i] + (1 - beta2_) * grads.cbegin()[i] * grads.cbegin()[i];
 
-            T t1_hat = T1.begin()[i] / (1 - std::pow(beta1_, T(t_)));
-            T t2_hat = T2.begin()[i] / (1 - std::pow(beta2_, T(t_)));
+            T t1_hat = T1.begin()[i] / correction1;
+            T t2_hat = T2.begin()[i] / correction2;
 
             params.begin()[i] -= lr_ * t1_hat / (std::sqrt(t2_hat) + epsilon_);
         }
     }
 
-    void step() override {}
+    void step() override { cursor_ = 0; }
+
+    void set_learning_rate(T learning_rate) override { lr_ = learning_rate; }
+
+    void save_state(std::ostream& out) const override {
+        detail::write_tag(out, "Adam");
+        detail::write_pod(out, static_cast<uint64_t>(t_));
+        detail::write_tensors(out, t1);
+        detail::write_tensors(out, t2);
+    }
+
+    void load_state(std::istream& in) override {
+        detail::expect_tag(in, "Adam");
+        uint64_t t = 0;
+        detail::read_pod(in, t);
+        t_ = static_cast<size_t>(t);
+        cursor_ = 0;
+        detail::read_tensors(in, t1);
+        detail::read_tensors(in, t2);
+    }
+};
+
+// LARS (You et al., 2017): SGD con momento donde cada tensor de pesos usa
+// una tasa local eta * ||w|| / (||g|| + wd * ||w||), para que ninguna capa
+// dé pasos desproporcionados a su escala con batches grandes. Los tensores
+// que la capa marca como ParamKind::Bias no llevan tasa local ni weight decay.
+template<typename T>
+class LARS final : public IOptimizer<T> {
+private:
+    T lr_, momentum_, weight_decay_, eta_;
+    size_t cursor_ = 0;
+    std::vector<utec::algebra::Tensor<T, 2>> velocity_;
+
+public:
+    explicit LARS(T lr = 0.1, T momentum = 0.9, T weight_decay = 1e-4, T eta = 0.001)
+        : lr_(lr), momentum_(momentum), weight_decay_(weight_decay), eta_(eta) {}
+
+    void update(utec::algebra::Tensor<T, 2>& params,
+                const utec::algebra::Tensor<T, 2>& grads) override {
+        update(params, grads, ParamKind::Weight);
+    }
+
+    void update(utec::algebra::Tensor<T, 2>& params,
+                const utec::algebra::Tensor<T, 2>& grads, ParamKind kind) override {
+        if (cursor_ == velocity_.size()) {
+            velocity_.emplace_back(grads.shape()[0], grads.shape()[1]);
+            velocity_.back().fill(T(0));
+        } else if (velocity_[cursor_].shape() != grads.shape()) {
+            throw std::runtime_error("LARS: parameter shapes changed between steps");
+        }
+        auto& v = velocity_[cursor_++];
+
+        const bool adapt = kind == ParamKind::Weight;
+        const T decay = adapt ? weight_decay_ : T(0);
+        T local = T(1);
+        if (adapt) {
+            const T w_norm = std::sqrt(detail::squared_norm(params));
+            const T g_norm = std::sqrt(detail::squared_norm(grads));
+            if (w_norm > T(0) && g_norm > T(0)) local = eta_ * w_norm / (g_norm + decay * w_norm);
+        }
+        const T scaled = lr_ * local;
+        for (size_t i = 0; i < params.size(); ++i) {
+            T& w = params.begin()[i];
+            T& m = v.begin()[i];
+            m = momentum_ * m + scaled * (grads.cbegin()[i] + decay * w);
+            w -= m;
+        }
+    }
+
+    void step() override { cursor_ = 0; }
+
+    void set_learning_rate(T learning_rate) override { lr_ = learning_rate; }
+
+    void save_state(std::ostream& out) const override {
+        detail::write_tag(out, "LARS");
+        detail::write_tensors(out, velocity_);
+    }
+
+    void load_state(std::istream& in) override {
+        detail::expect_tag(in, "LARS");
+        cursor_ = 0;
+        detail::read_tensors(in, velocity_);
+    }
+};
+
+// LAMB (You et al., 2019): la dirección de Adam (más weight decay) escalada
+// por tensor con ||w|| / ||dirección||. Misma regla que LARS para sesgos.
+template<typename T>
+class LAMB final : public IOptimizer<T> {
+private:
+    T lr_, beta1_, beta2_, epsilon_, weight_decay_;
+    size_t t_ = 0;
+    size_t cursor_ = 0;
+    std::vector<utec::algebra::Tensor<T, 2>> t1, t2;
+    std::vector<T> direction_;
+
+public:
+    explicit LAMB(T lr = 0.001, T beta1 = 0.9, T beta2 = 0.999, T epsilon = 1e-6, T weight_decay = 0.01)
+        : lr_(lr), beta1_(beta1), beta2_(beta2), epsilon_(epsilon), weight_decay_(weight_decay) {}
+
+    void update(utec::algebra::Tensor<T, 2>& params,
+                const utec::algebra::Tensor<T, 2>& grads) override {
+        update(params, grads, ParamKind::Weight);
+    }
+
+    void update(utec::algebra::Tensor<T, 2>& params,
+                const utec::algebra::Tensor<T, 2>& grads, ParamKind kind) override {
+        if (cursor_ == 0) t_++;
+        if (cursor_ == t1.size()) {
+            t1.emplace_back(grads.shape()[0], grads.shape()[1]);
+            t2.emplace_back(grads.shape()[0], grads.shape()[1]);
+            t1.back().fill(T(0));
+            t2.back().fill(T(0));
+        } else if (t1[cursor_].shape() != grads.shape()) {
+            throw std::runtime_error("LAMB: parameter shapes changed between steps");
+        }
+
+        auto& T1 = t1[cursor_];
+        auto& T2 = t2[cursor_];
+        cursor_++;
+
+        const bool adapt = kind == ParamKind::Weight;
+        const T decay = adapt ? weight_decay_ : T(0);
+        const T correction1 = 1 - std::pow(beta1_, T(t_));
+        const T correction2 = 1 - std::pow(beta2_, T(t_));
+        direction_.resize(params.size());
+        T r_sq = T(0);
+        for (size_t i = 0; i < grads.size(); ++i) {
+            const T g = grads.cbegin()[i];
+            T1.begin()[i] = beta1_ * T1.begin()[i] + (1 - beta1_) * g;
+            T2.begin()[i] = beta2_ * T2.begin()[i] + (1 - beta2_) * g * g;
+            const T r = (T1.begin()[i] / correction1) / (std::sqrt(T2.begin()[i] / correction2) + epsilon_)
+                      + decay * params.cbegin()[i];
+            direction_[i] = r;
+            r_sq += r * r;
+        }
+
+        T trust = T(1);
+        if (adapt) {
+            const T w_norm = std::sqrt(detail::squared_norm(params));
+            const T r_norm = std::sqrt(r_sq);
+            if (w_norm > T(0) && r_norm > T(0)) trust = w_norm / r_norm;
+        }
+        const T scaled = lr_ * trust;
+        for (size_t i = 0; i < params.size(); ++i)
+            params.begin()[i] -= scaled * direction_[i];
+    }
+
+    void step() override { cursor_ = 0; }
+
+    void set_learning_rate(T learning_rate) override { lr_ = learning_rate; }
+
+    void save_state(std::ostream& out) const override {
+        detail::write_tag(out, "LAMB");
+        detail::write_pod(out, static_cast<uint64_t>(t_));
+        detail::write_tensors(out, t1);
+        detail::write_tensors(out, t2);
+    }
+
+    void load_state(std::istream& in) override {
+        detail::expect_tag(in, "LAMB");
+        uint64_t t = 0;
+        detail::read_pod(in, t);
+        t_ = static_cast<size_t>(t);
+        cursor_ = 0;
+        detail::read_tensors(in, t1);
+        detail::read_tensors(in, t2);
+    }
 };
 
 } // namespace neural_network
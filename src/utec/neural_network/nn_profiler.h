@@ -0,0 +1,247 @@
+//
+// Profiler por capa y fase para train/predict.
+//
+// Solo existe al compilar con UTEC_NN_PROFILE: sin esa macro NN_PROFILE_SCOPE
+// no expande a nada (ni siquiera evalúa sus argumentos). Cada ámbito registra
+// tiempo de pared, FLOPs y bytes estimados y las reservas de Tensor hechas
+// dentro. El resumen agrupa por capa y fase a medida que llegan los eventos;
+// la línea de tiempo guarda como mucho max_events() (los primeros, el resto
+// solo cuenta en el resumen) y se exporta en el formato de eventos de Chrome
+// (chrome://tracing o ui.perfetto.dev).
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_PROFILER_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_PROFILER_H
+
+#include "../algebra/tensor.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+
+namespace utec::neural_network::profiler {
+
+enum class Phase { Step, BatchCopy, Forward, Loss, Backward, Update, Predict };
+
+inline const char* phase_name(Phase phase) {
+    switch (phase) {
+    case Phase::Step: return "step";
+    case Phase::BatchCopy: return "batch_copy";
+    case Phase::Forward: return "forward";
+    case Phase::Loss: return "loss";
+    case Phase::Backward: return "backward";
+    case Phase::Update: return "update";
+    case Phase::Predict: return "predict";
+    }
+    return "?";
+}
+
+struct Event {
+    std::string name;
+    Phase phase;
+    uint32_t thread;
+    double start_us, duration_us;
+    uint64_t flops, bytes, allocations;
+};
+
+// Acumulado de un (fase, capa) sobre todos los eventos, guardados o no.
+struct Totals {
+    uint64_t calls = 0, flops = 0, bytes = 0, allocations = 0;
+    double us = 0;
+};
+
+class Profiler {
+private:
+    using clock = std::chrono::steady_clock;
+
+    clock::time_point origin_ = clock::now();
+    std::vector<Event> events_;
+    std::map<std::pair<int, std::string>, Totals> totals_;
+    size_t max_events_ = size_t(1) << 18;
+    uint64_t dropped_ = 0;
+    mutable std::mutex mutex_;
+    std::atomic<bool> enabled_{true};
+
+    Profiler() = default;
+
+public:
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    static uint32_t thread_index() {
+        static std::atomic<uint32_t> next{0};
+        thread_local uint32_t index = next++;
+        return index;
+    }
+
+    double now_us() const {
+        return std::chrono::duration<double, std::micro>(clock::now() - origin_).count();
+    }
+
+    bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+    void set_enabled(bool enabled) noexcept { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    void record(Event event) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& row = totals_[{static_cast<int>(event.phase), event.name}];
+        ++row.calls;
+        row.us += event.duration_us;
+        row.flops += event.flops;
+        row.bytes += event.bytes;
+        row.allocations += event.allocations;
+        if (events_.size() < max_events_) events_.push_back(std::move(event));
+        else ++dropped_;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.clear();
+        totals_.clear();
+        dropped_ = 0;
+    }
+
+    // Tope de la línea de tiempo; no recorta lo ya guardado.
+    size_t max_events() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return max_events_;
+    }
+    void set_max_events(size_t max_events) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        max_events_ = max_events;
+    }
+
+    // Eventos que no entraron en la línea de tiempo desde el último clear.
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_;
+    }
+
+    std::vector<Event> events() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_;
+    }
+
+    std::map<std::pair<int, std::string>, Totals> totals() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return totals_;
+    }
+
+    // Tabla por (capa, fase). El porcentaje es sobre el tiempo de los
+    // ámbitos hoja (todo menos "step", que los contiene).
+    void summary(std::ostream& out) const {
+        const auto rows = totals();
+        double total_us = 0;
+        for (const auto& [key, row] : rows)
+            if (key.first != static_cast<int>(Phase::Step)) total_us += row.us;
+
+        out << std::left << std::setw(12) << "fase" << std::setw(24) << "capa" << std::right
+            << std::setw(8) << "llamadas" << std::setw(12) << "total ms" << std::setw(10) << "prom us"
+            << std::setw(8) << "%" << std::setw(10) << "GFLOP/s" << std::setw(10) << "GB/s"
+            << std::setw(10) << "reservas" << "\n";
+        out << std::fixed;
+        for (const auto& [key, row] : rows) {
+            const double seconds = row.us * 1e-6;
+            out << std::left << std::setw(12) << phase_name(static_cast<Phase>(key.first))
+                << std::setw(24) << key.second << std::right
+                << std::setw(8) << row.calls
+                << std::setw(12) << std::setprecision(2) << row.us / 1000.0
+                << std::setw(10) << std::setprecision(1) << row.us / double(row.calls)
+                << std::setw(8) << (key.first == static_cast<int>(Phase::Step) || total_us == 0
+                                    ? 0.0 : 100.0 * row.us / total_us)
+                << std::setw(10) << std::setprecision(2) << (seconds > 0 ? row.flops / seconds * 1e-9 : 0.0)
+                << std::setw(10) << (seconds > 0 ? row.bytes / seconds * 1e-9 : 0.0)
+                << std::setw(10) << row.allocations << "\n";
+        }
+        out << std::defaultfloat << std::setprecision(6);
+        if (const uint64_t lost = dropped())
+            out << lost << " eventos fuera de la traza (max_events " << max_events() << ")\n";
+    }
+
+    // Eventos completos ("ph": "X") con tiempos en microsegundos.
+    void write_chrome_trace(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("Cannot open trace file " + path);
+        }
+        auto escape = [](const std::string& s) {
+            std::string r;
+            for (char c : s) {
+                if (c == '"' || c == '\\') r += '\\';
+                r += c;
+            }
+            return r;
+        };
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        const auto all = events();
+        out << std::fixed << std::setprecision(3);
+        for (size_t i = 0; i < all.size(); ++i) {
+            const auto& e = all[i];
+            out << "{\"name\":\"" << escape(e.name) << "\",\"cat\":\"" << phase_name(e.phase)
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread
+                << ",\"ts\":" << e.start_us << ",\"dur\":" << e.duration_us
+                << ",\"args\":{\"flops\":" << e.flops << ",\"bytes\":" << e.bytes
+                << ",\"allocations\":" << e.allocations << "}}" << (i + 1 < all.size() ? ",\n" : "\n");
+        }
+        out << "]}\n";
+    }
+};
+
+// Mide desde la construcción hasta la destrucción.
+class Scope {
+private:
+    Event event_;
+    uint64_t allocations_at_start_;
+    bool active_;
+
+public:
+    Scope(std::string name, Phase phase, uint64_t flops = 0, uint64_t bytes = 0)
+        : active_(Profiler::instance().enabled()) {
+        if (!active_) return;
+        event_.name = std::move(name);
+        event_.phase = phase;
+        event_.thread = Profiler::thread_index();
+        event_.flops = flops;
+        event_.bytes = bytes;
+        allocations_at_start_ = algebra::telemetry::thread_allocations();
+        event_.start_us = Profiler::instance().now_us();
+    }
+
+    // cost: {FLOPs, bytes}
+    Scope(std::string name, Phase phase, std::pair<uint64_t, uint64_t> cost)
+        : Scope(std::move(name), phase, cost.first, cost.second) {}
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope() {
+        if (!active_) return;
+        auto& profiler = Profiler::instance();
+        event_.duration_us = profiler.now_us() - event_.start_us;
+        event_.allocations = algebra::telemetry::thread_allocations() - allocations_at_start_;
+        profiler.record(std::move(event_));
+    }
+};
+
+} // namespace utec::neural_network::profiler
+
+#define NN_PROFILE_CONCAT_(a, b) a##b
+#define NN_PROFILE_CONCAT(a, b) NN_PROFILE_CONCAT_(a, b)
+
+#ifdef UTEC_NN_PROFILE
+#define NN_PROFILE_SCOPE(...) \
+    ::utec::neural_network::profiler::Scope NN_PROFILE_CONCAT(nn_profile_scope_, __LINE__)(__VA_ARGS__)
+#else
+#define NN_PROFILE_SCOPE(...) ((void)0)
+#endif
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_PROFILER_H
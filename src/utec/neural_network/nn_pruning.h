@@ -0,0 +1,127 @@
+//
+// Poda por magnitud de capas Dense: de una vez hasta una dispersión objetivo
+// o gradual durante el entrenamiento.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_PRUNING_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_PRUNING_H
+
+#include "nn_interfaces.h"
+#include "nn_dense.h"
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+namespace utec::neural_network {
+
+// Pone en cero los pesos de menor magnitud hasta que una fracción `sparsity`
+// de ellos sea cero. Devuelve la máscara resultante (1 = peso vivo).
+template<typename T>
+std::vector<uint8_t> prune_by_magnitude(Dense<T>& dense, double sparsity) {
+    if (sparsity < 0.0 || sparsity >= 1.0) {
+        throw std::runtime_error("Sparsity must be in [0, 1)");
+    }
+    auto& weights = *dense.parameters()[0];
+    const size_t n = weights.data.size();
+    const size_t prune = static_cast<size_t>(std::floor(sparsity * static_cast<double>(n)));
+
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = i;
+    // Desempate por índice para que la poda sea determinista.
+    std::nth_element(order.begin(), order.begin() + prune, order.end(), [&](size_t a, size_t b) {
+        const T ma = std::abs(weights.data[a]), mb = std::abs(weights.data[b]);
+        return ma < mb || (ma == mb && a < b);
+    });
+
+    std::vector<uint8_t> mask(n, 1);
+    for (size_t i = 0; i < prune; ++i) {
+        mask[order[i]] = 0;
+        weights.data[order[i]] = T(0);
+    }
+    return mask;
+}
+
+// Fracción de pesos en cero.
+template<typename T>
+double sparsity_of(const Dense<T>& dense) {
+    const size_t n = dense.in_features() * dense.out_features();
+    const T* w = dense.weights_data();
+    return n ? double(std::count(w, w + n, T(0))) / double(n) : 0.0;
+}
+
+// Poda gradual (Zhu y Gupta, 2017): la dispersión crece de `initial` a
+// `final` entre `begin_step` y `end_step` siguiendo una curva cúbica, y se
+// actualiza cada `frequency` pasos. Entre actualizaciones la máscara se
+// reaplica tras cada paso para que los pesos podados sigan en cero.
+struct PruningSchedule {
+    double initial_sparsity = 0.0;
+    double final_sparsity = 0.9;
+    uint64_t begin_step = 0;
+    uint64_t end_step = 1000;
+    uint64_t frequency = 100;
+    std::vector<size_t> dense_layers; // índices entre las capas Dense; vacío = todas
+
+    double sparsity_at(uint64_t step) const {
+        if (step <= begin_step) return initial_sparsity;
+        if (step >= end_step) return final_sparsity;
+        const double progress = double(step - begin_step) / double(end_step - begin_step);
+        return final_sparsity + (initial_sparsity - final_sparsity) * std::pow(1.0 - progress, 3.0);
+    }
+};
+
+template<typename T>
+class GradualPruner {
+private:
+    PruningSchedule schedule_;
+    std::vector<std::vector<uint8_t>> masks_;
+
+    std::vector<Dense<T>*> targets(std::vector<std::unique_ptr<ILayer<T>>>& layers) const {
+        std::vector<Dense<T>*> dense;
+        for (auto& layer : layers)
+            if (auto d = dynamic_cast<Dense<T>*>(layer.get())) dense.push_back(d);
+        if (schedule_.dense_layers.empty()) return dense;
+
+        std::vector<Dense<T>*> selected;
+        for (size_t index : schedule_.dense_layers) {
+            if (index >= dense.size()) {
+                throw std::runtime_error("Pruning schedule refers to a missing Dense layer");
+            }
+            selected.push_back(dense[index]);
+        }
+        return selected;
+    }
+
+public:
+    explicit GradualPruner(PruningSchedule schedule) : schedule_(std::move(schedule)) {
+        if (schedule_.end_step <= schedule_.begin_step || schedule_.frequency == 0) {
+            throw std::runtime_error("Invalid pruning schedule");
+        }
+    }
+
+    // Llamar después de cada paso del optimizador.
+    void on_step(std::vector<std::unique_ptr<ILayer<T>>>& layers, uint64_t step) {
+        auto dense = targets(layers);
+        const bool update = step >= schedule_.begin_step && step <= schedule_.end_step
+                         && (step - schedule_.begin_step) % schedule_.frequency == 0;
+        if (update || masks_.size() != dense.size()) {
+            masks_.clear();
+            for (auto* d : dense)
+                masks_.push_back(prune_by_magnitude(*d, schedule_.sparsity_at(step)));
+            return;
+        }
+        for (size_t i = 0; i < dense.size(); ++i) {
+            auto& weights = *dense[i]->parameters()[0];
+            for (size_t k = 0; k < weights.data.size(); ++k)
+                if (!masks_[i][k]) weights.data[k] = T(0);
+        }
+    }
+
+    const PruningSchedule& schedule() const { return schedule_; }
+};
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_PRUNING_H
@@ -0,0 +1,190 @@
+//
+// Cuantización post-entrenamiento a int8 e inferencia con GEMM entero.
+//
+// Pesos: int8 simétrico por canal de salida. Activaciones: 7 bits sin signo
+// (0..127) con escala y punto cero por capa, calibrados sobre un conjunto de
+// muestra. El producto acumula en int32 y el epílogo del GEMM aplica sesgo,
+// ReLU y la recuantización a la entrada de la capa siguiente en una pasada.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_QUANTIZATION_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_QUANTIZATION_H
+
+#include "neural_network.h"
+#include "../algebra/simd.h"
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace utec::neural_network {
+
+struct QuantParams {
+    float scale = 1.0f;
+    int32_t zero_point = 0;
+
+    // Rango [lo, hi] -> 0..127, con el cero exactamente representable.
+    static QuantParams from_range(float lo, float hi) {
+        lo = std::min(lo, 0.0f);
+        hi = std::max(hi, 0.0f);
+        QuantParams p;
+        p.scale = hi > lo ? (hi - lo) / 127.0f : 1.0f;
+        p.zero_point = std::clamp(static_cast<int32_t>(std::nearbyint(-lo / p.scale)), 0, 127);
+        return p;
+    }
+
+    uint8_t quantize(float v) const {
+        const int32_t q = static_cast<int32_t>(std::nearbyint(v / scale)) + zero_point;
+        return static_cast<uint8_t>(std::clamp(q, 0, 127));
+    }
+};
+
+template<typename T>
+class QuantizedNetwork {
+private:
+    enum class Activation { None, ReLU, Sigmoid };
+
+    struct Stage {
+        size_t in_f = 0, out_f = 0, k_pad = 0;
+        std::vector<int8_t> weights;   // out_f x k_pad, una fila por canal de salida
+        std::vector<float> multiplier; // escala_entrada * escala_canal
+        std::vector<float> offset;     // sesgo - multiplier * zp * suma(pesos del canal)
+        QuantParams input;
+        Activation activation = Activation::None;
+    };
+
+    std::vector<Stage> stages_;
+
+    static constexpr size_t K_BLOCK = 32;
+
+    // Entradas de cada Dense sobre la muestra de calibración.
+    static std::vector<std::pair<float, float>> calibrate(const NeuralNetwork<T>& nn,
+                                                          const algebra::Tensor<T, 2>& sample) {
+        std::vector<std::pair<float, float>> ranges;
+        algebra::Tensor<T, 2> current = sample;
+        for (const auto& layer : nn.dlayers()) {
+            if (dynamic_cast<const Dense<T>*>(layer.get())) {
+                float lo = std::numeric_limits<float>::max(), hi = std::numeric_limits<float>::lowest();
+                for (const T& v : current) {
+                    lo = std::min(lo, static_cast<float>(v));
+                    hi = std::max(hi, static_cast<float>(v));
+                }
+                ranges.emplace_back(lo, hi);
+            }
+            current = layer->infer(current);
+        }
+        return ranges;
+    }
+
+    static Stage quantize_dense(const Dense<T>& dense, QuantParams input) {
+        Stage s;
+        s.in_f = dense.in_features();
+        s.out_f = dense.out_features();
+        s.k_pad = (s.in_f + K_BLOCK - 1) / K_BLOCK * K_BLOCK;
+        s.input = input;
+        s.weights.assign(s.out_f * s.k_pad, 0);
+        s.multiplier.resize(s.out_f);
+        s.offset.resize(s.out_f);
+
+        const T* w = dense.weights_data();
+        const T* b = dense.biases_data();
+        for (size_t j = 0; j < s.out_f; ++j) {
+            float max_abs = 0.0f;
+            for (size_t k = 0; k < s.in_f; ++k)
+                max_abs = std::max(max_abs, std::abs(static_cast<float>(w[k * s.out_f + j])));
+            const float w_scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+
+            int32_t w_sum = 0;
+            int8_t* row = &s.weights[j * s.k_pad];
+            for (size_t k = 0; k < s.in_f; ++k) {
+                const int32_t q = static_cast<int32_t>(std::nearbyint(static_cast<float>(w[k * s.out_f + j]) / w_scale));
+                row[k] = static_cast<int8_t>(std::clamp(q, -127, 127));
+                w_sum += row[k];
+            }
+            s.multiplier[j] = input.scale * w_scale;
+            s.offset[j] = static_cast<float>(b[j]) - s.multiplier[j] * static_cast<float>(input.zero_point * w_sum);
+        }
+        return s;
+    }
+
+public:
+    // Cuantiza una red Dense/ReLU/Sigmoid ya entrenada. `calibration` son
+    // muestras representativas (por ejemplo, un batch de MNISTLoader).
+    static QuantizedNetwork build(const NeuralNetwork<T>& nn, const algebra::Tensor<T, 2>& calibration) {
+        const auto ranges = calibrate(nn, calibration);
+        QuantizedNetwork q;
+        size_t dense_index = 0;
+        for (const auto& layer : nn.dlayers()) {
+            if (auto dense = dynamic_cast<const Dense<T>*>(layer.get())) {
+                if (!q.stages_.empty() && q.stages_.back().out_f != dense->in_features()) {
+                    throw std::runtime_error("Incompatible layer sizes in quantized network");
+                }
+                const auto [lo, hi] = ranges[dense_index++];
+                q.stages_.push_back(quantize_dense(*dense, QuantParams::from_range(lo, hi)));
+                continue;
+            }
+            if (q.stages_.empty() || q.stages_.back().activation != Activation::None) {
+                throw std::runtime_error("Quantized network expects each activation to follow a Dense layer");
+            }
+            if (dynamic_cast<const ReLU<T>*>(layer.get())) q.stages_.back().activation = Activation::ReLU;
+            else if (dynamic_cast<const Sigmoid<T>*>(layer.get())) q.stages_.back().activation = Activation::Sigmoid;
+            else throw std::runtime_error("Layer type not supported by the quantized network");
+        }
+        if (q.stages_.empty()) {
+            throw std::runtime_error("Quantized network needs at least one Dense layer");
+        }
+        return q;
+    }
+
+    algebra::Tensor<T, 2> predict(const algebra::Tensor<T, 2>& X) const {
+        const size_t n = X.shape()[0];
+        if (X.shape()[1] != stages_.front().in_f) {
+            throw std::runtime_error("Input size does not match the quantized network");
+        }
+
+        const Stage& first = stages_.front();
+        std::vector<uint8_t> current(n * first.k_pad, 0), next;
+        for (size_t r = 0; r < n; ++r)
+            for (size_t k = 0; k < first.in_f; ++k)
+                current[r * first.k_pad + k] = first.input.quantize(static_cast<float>(X(r, k)));
+
+        algebra::Tensor<T, 2> output(n, stages_.back().out_f);
+        for (size_t s = 0; s < stages_.size(); ++s) {
+            const Stage& stage = stages_[s];
+            const bool last = s + 1 == stages_.size();
+            const QuantParams* out_q = last ? nullptr : &stages_[s + 1].input;
+            const size_t out_pad = last ? 0 : stages_[s + 1].k_pad;
+            if (!last) next.assign(n * out_pad, 0);
+
+            for (size_t r = 0; r < n; ++r) {
+                const uint8_t* a = &current[r * stage.k_pad];
+                for (size_t j = 0; j < stage.out_f; ++j) {
+                    const int32_t acc = algebra::simd::dot_u8s8(a, &stage.weights[j * stage.k_pad], stage.k_pad);
+                    float z = stage.multiplier[j] * static_cast<float>(acc) + stage.offset[j];
+                    if (stage.activation == Activation::ReLU) z = z > 0.0f ? z : 0.0f;
+                    else if (stage.activation == Activation::Sigmoid) z = 1.0f / (1.0f + std::exp(-z));
+                    if (last) output(r, j) = static_cast<T>(z);
+                    else next[r * out_pad + j] = out_q->quantize(z);
+                }
+            }
+            if (!last) current.swap(next);
+        }
+        return output;
+    }
+
+    size_t layers() const { return stages_.size(); }
+
+    // Bytes de pesos y parámetros de recuantización.
+    size_t size_bytes() const {
+        size_t total = 0;
+        for (const auto& s : stages_)
+            total += s.weights.size() + (s.multiplier.size() + s.offset.size()) * sizeof(float);
+        return total;
+    }
+};
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_QUANTIZATION_H
@@ -0,0 +1,253 @@
+//
+// Números aleatorios reproducibles para inicializar, barajar y Dropout.
+//
+// Un Stream es (semilla, id) sobre Philox4x32 (ver algebra/philox.h): el
+// valor i de un flujo no depende de nada más, así que llenar un tensor en
+// paralelo da lo mismo con 1 hilo o con 16. split(n) deriva flujos
+// independientes (uno por capa, por época, por hilo...).
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_RANDOM_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_RANDOM_H
+
+#include "nn_interfaces.h"
+#include "../algebra/tensor.h"
+#include "../algebra/philox.h"
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <utility>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace utec::neural_network {
+
+namespace rng {
+
+// Mezcla de splitmix64: ids derivados bien separados.
+inline uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Reparte [0, n) en `threads` tramos contiguos y llama body(begin, end) en
+// cada uno. threads == 0 usa todos los núcleos; tramos chicos no valen un hilo.
+template<typename Body>
+void parallel_for(size_t n, unsigned threads, Body body) {
+    constexpr size_t MIN_PER_THREAD = size_t(1) << 14;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(1, n / MIN_PER_THREAD)));
+    if (threads <= 1) {
+        body(size_t(0), n);
+        return;
+    }
+    std::vector<std::thread> workers;
+    const size_t chunk = (n + threads - 1) / threads;
+    for (unsigned t = 1; t < threads; ++t) {
+        const size_t begin = std::min(n, t * chunk), end = std::min(n, begin + chunk);
+        workers.emplace_back([=] { body(begin, end); });
+    }
+    body(0, std::min(n, chunk));
+    for (auto& w : workers) w.join();
+}
+
+class Stream {
+private:
+    uint64_t seed_ = 0;
+    uint64_t id_ = 0;
+
+    // Palabras [first, first + n) convertidas por `convert` en tandas.
+    template<typename Convert>
+    void generate(size_t n, uint64_t first, Convert convert) const {
+        constexpr size_t TILE = 1024;
+        uint32_t words[TILE];
+        for (size_t done = 0; done < n; done += TILE) {
+            const size_t count = std::min(TILE, n - done);
+            algebra::philox::fill_words(words, count, first + done, id_, seed_);
+            convert(done, words, count);
+        }
+    }
+
+public:
+    Stream() = default;
+    explicit Stream(uint64_t seed, uint64_t id = 0) : seed_(seed), id_(id) {}
+
+    Stream split(uint64_t child) const { return Stream(seed_, mix(id_ ^ mix(child))); }
+
+    uint64_t seed() const noexcept { return seed_; }
+    uint64_t id() const noexcept { return id_; }
+
+    uint32_t bits(uint64_t index) const {
+        return algebra::philox::block(index / 4, id_, seed_)[index % 4];
+    }
+
+    // Uniforme en [0, 1) con 24 bits, igual para float y double.
+    static double to_unit(uint32_t word) { return double(word >> 8) * (1.0 / 16777216.0); }
+
+    double uniform(uint64_t index) const { return to_unit(bits(index)); }
+
+    // Entero en [0, bound) (multiplicar y desplazar, sesgo < bound / 2^32).
+    uint32_t below(uint64_t index, uint32_t bound) const {
+        return static_cast<uint32_t>((uint64_t(bits(index)) * bound) >> 32);
+    }
+
+    // out[i] = lo + (hi - lo) * u(offset + i).
+    template<typename T>
+    void fill_uniform(T* out, size_t n, T lo, T hi, uint64_t offset = 0, unsigned threads = 1) const {
+        const double width = double(hi) - double(lo);
+        parallel_for(n, threads, [&](size_t begin, size_t end) {
+            generate(end - begin, offset + begin, [&](size_t at, const uint32_t* words, size_t count) {
+                T* dst = out + begin + at;
+                for (size_t i = 0; i < count; ++i) dst[i] = static_cast<T>(double(lo) + width * to_unit(words[i]));
+            });
+        });
+    }
+
+    // Normal por Box-Muller; el elemento i usa las palabras 2i y 2i + 1.
+    template<typename T>
+    void fill_normal(T* out, size_t n, T mean, T stddev, uint64_t offset = 0, unsigned threads = 1) const {
+        const double two_pi = 2.0 * std::acos(-1.0);
+        parallel_for(n, threads, [&](size_t begin, size_t end) {
+            generate(2 * (end - begin), 2 * (offset + begin), [&](size_t at, const uint32_t* words, size_t count) {
+                T* dst = out + begin + at / 2;
+                for (size_t i = 0; i + 1 < count; i += 2) {
+                    const double u1 = 1.0 - to_unit(words[i]);   // (0, 1]
+                    const double u2 = to_unit(words[i + 1]);
+                    dst[i / 2] = static_cast<T>(double(mean) + double(stddev) * std::sqrt(-2.0 * std::log(u1)) * std::cos(two_pi * u2));
+                }
+            });
+        });
+    }
+};
+
+// Fisher-Yates con el sorteo k tomado de la palabra k del flujo.
+template<typename It>
+void shuffle(It first, It last, const Stream& stream) {
+    const size_t n = static_cast<size_t>(last - first);
+    for (size_t i = n; i > 1; --i) {
+        const size_t j = stream.below(n - i, static_cast<uint32_t>(i));
+        std::swap(first[i - 1], first[j]);
+    }
+}
+
+namespace detail {
+    template<typename Tensor>
+    using value_t = std::decay_t<decltype(*std::declval<Tensor&>().begin())>;
+}
+
+// Inicializadores para el constructor de Dense: pesos in_f x out_f, así
+// que fan_in = filas y fan_out = columnas.
+inline auto uniform(double lo, double hi, Stream stream, unsigned threads = 0) {
+    return [=](auto& w) {
+        using T = detail::value_t<decltype(w)>;
+        stream.fill_uniform<T>(w.data.data(), w.size(), T(lo), T(hi), 0, threads);
+    };
+}
+
+// Glorot: U(-a, a) con a = sqrt(6 / (fan_in + fan_out)). Para tanh/sigmoid.
+inline auto xavier_uniform(Stream stream, unsigned threads = 0) {
+    return [=](auto& w) {
+        using T = detail::value_t<decltype(w)>;
+        const double a = std::sqrt(6.0 / double(w.shape()[0] + w.shape()[1]));
+        stream.fill_uniform<T>(w.data.data(), w.size(), T(-a), T(a), 0, threads);
+    };
+}
+
+// He: N(0, 2 / fan_in). Para capas seguidas de ReLU.
+inline auto he_normal(Stream stream, unsigned threads = 0) {
+    return [=](auto& w) {
+        using T = detail::value_t<decltype(w)>;
+        stream.fill_normal<T>(w.data.data(), w.size(), T(0), T(std::sqrt(2.0 / double(w.shape()[0]))), 0, threads);
+    };
+}
+
+// He uniforme: U(-a, a) con a = sqrt(6 / fan_in).
+inline auto he_uniform(Stream stream, unsigned threads = 0) {
+    return [=](auto& w) {
+        using T = detail::value_t<decltype(w)>;
+        const double a = std::sqrt(6.0 / double(w.shape()[0]));
+        stream.fill_uniform<T>(w.data.data(), w.size(), T(-a), T(a), 0, threads);
+    };
+}
+
+} // namespace rng
+
+// Dropout invertido: en entrenamiento apaga cada valor con probabilidad
+// `rate` y escala los demás por 1 / (1 - rate); infer es la identidad. La
+// máscara del forward k sale de stream.split(k), así que no depende de
+// hilos ni del orden. Tras clear_cache (checkpointing de activaciones) el
+// siguiente forward repite la máscara anterior en vez de sortear otra.
+template<typename T>
+class Dropout final : public ILayer<T> {
+private:
+    T rate_ = T(0.5);
+    rng::Stream stream_;
+    uint64_t draws_ = 0;
+    bool replay_ = false;
+    algebra::Tensor<T, 2> mask;
+
+public:
+    Dropout() : mask(0, 0) {}
+
+    // Sin flujo por defecto: dos capas con el mismo flujo sacarían las mismas
+    // máscaras (usar p. ej. rng::Stream(seed, indice_de_capa)).
+    Dropout(T rate, rng::Stream stream) : rate_(rate), stream_(stream), mask(0, 0) {
+        if (!(rate >= T(0) && rate < T(1))) throw std::runtime_error("Dropout rate must be in [0, 1)");
+    }
+
+    algebra::Tensor<T, 2> forward(const algebra::Tensor<T, 2>& x) override {
+        const uint64_t draw = replay_ ? draws_ - 1 : draws_++;
+        replay_ = false;
+        mask = algebra::Tensor<T, 2>(x.shape()[0], x.shape()[1]);
+        stream_.split(draw).fill_uniform<T>(mask.data.data(), mask.size(), T(0), T(1));
+        const T keep = T(1) / (T(1) - rate_);
+        auto out = x;
+        for (size_t i = 0; i < out.size(); ++i) {
+            mask.data[i] = mask.data[i] < rate_ ? T(0) : keep;
+            out.data[i] *= mask.data[i];
+        }
+        return out;
+    }
+
+    algebra::Tensor<T, 2> infer(const algebra::Tensor<T, 2>& x) const override {
+        return x;
+    }
+
+    algebra::Tensor<T, 2> backward(const algebra::Tensor<T, 2>& g) override {
+        auto out = g;
+        for (size_t i = 0; i < out.size(); ++i) out.data[i] *= mask.data[i];
+        mask = algebra::Tensor<T, 2>(0, 0);
+        return out;
+    }
+
+    // Solo una máscara todavía sin usar en backward se repite.
+    void clear_cache() override {
+        if (mask.size() == 0) return;
+        mask = algebra::Tensor<T, 2>(0, 0);
+        replay_ = true;
+    }
+
+    // Incluye cuántas máscaras se sacaron: al cargar sigue con la siguiente.
+    void save(std::ostream& out) const {
+        out << rate_ << " " << stream_.seed() << " " << stream_.id() << " " << draws_ << "\n";
+    }
+
+    void load(std::istream& in) {
+        uint64_t seed = 0, id = 0;
+        in >> rate_ >> seed >> id >> draws_;
+        if (!in || !(rate_ >= T(0) && rate_ < T(1))) throw std::runtime_error("Corrupt Dropout layer");
+        stream_ = rng::Stream(seed, id);
+        replay_ = false;
+    }
+
+    T rate() const noexcept { return rate_; }
+};
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_RANDOM_H
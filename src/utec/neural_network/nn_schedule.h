@@ -0,0 +1,102 @@
+//
+// Programas de tasa de aprendizaje. train consulta el programa antes de cada
+// paso del optimizador con el contador global de pasos (el mismo que guardan
+// los checkpoints), así que al retomar se sigue la misma curva.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_SCHEDULE_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_SCHEDULE_H
+
+#include <cmath>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+namespace utec::neural_network {
+
+template<typename T>
+struct LRSchedule {
+    virtual ~LRSchedule() = default;
+    // Tasa para el paso `step` (desde 0); `base` es la que recibió train.
+    virtual T rate(uint64_t step, T base) const = 0;
+};
+
+// Multiplica por `gamma` cada `step_size` pasos.
+template<typename T>
+struct StepDecay final : LRSchedule<T> {
+    uint64_t step_size;
+    T gamma;
+
+    explicit StepDecay(uint64_t step_size, T gamma = T(0.1)) : step_size(step_size), gamma(gamma) {
+        if (step_size == 0) throw std::runtime_error("StepDecay needs a positive step size");
+    }
+
+    T rate(uint64_t step, T base) const override {
+        return base * static_cast<T>(std::pow(gamma, static_cast<T>(step / step_size)));
+    }
+};
+
+// Medio coseno de base a base * min_factor en total_steps; después queda fija.
+template<typename T>
+struct Cosine final : LRSchedule<T> {
+    uint64_t total_steps;
+    T min_factor;
+
+    explicit Cosine(uint64_t total_steps, T min_factor = T(0)) : total_steps(total_steps), min_factor(min_factor) {
+        if (total_steps == 0) throw std::runtime_error("Cosine schedule needs a positive length");
+    }
+
+    T rate(uint64_t step, T base) const override {
+        const double progress = std::min(1.0, double(step) / double(total_steps));
+        const double factor = min_factor + (1.0 - min_factor) * 0.5 * (1.0 + std::cos(std::acos(-1.0) * progress));
+        return base * static_cast<T>(factor);
+    }
+};
+
+// Sube linealmente de 0 a base en `warmup_steps` y después sigue `after`
+// (desplazado para que arranque en 0); sin `after`, base constante.
+template<typename T>
+struct Warmup final : LRSchedule<T> {
+    uint64_t warmup_steps;
+    std::shared_ptr<const LRSchedule<T>> after;
+
+    explicit Warmup(uint64_t warmup_steps, std::shared_ptr<const LRSchedule<T>> after = nullptr)
+        : warmup_steps(warmup_steps), after(std::move(after)) {}
+
+    T rate(uint64_t step, T base) const override {
+        if (step < warmup_steps) return base * static_cast<T>(double(step + 1) / double(warmup_steps));
+        return after ? after->rate(step - warmup_steps, base) : base;
+    }
+};
+
+// One-cycle (Smith, 2018): de base / div_factor sube a base durante
+// pct_start del total y luego baja por coseno hasta base / final_div.
+template<typename T>
+struct OneCycle final : LRSchedule<T> {
+    uint64_t total_steps;
+    double pct_start, div_factor, final_div;
+
+    explicit OneCycle(uint64_t total_steps, double pct_start = 0.3, double div_factor = 25.0, double final_div = 1e4)
+        : total_steps(total_steps), pct_start(pct_start), div_factor(div_factor), final_div(final_div) {
+        if (total_steps < 2 || pct_start <= 0.0 || pct_start >= 1.0) {
+            throw std::runtime_error("Invalid one-cycle schedule");
+        }
+    }
+
+    T rate(uint64_t step, T base) const override {
+        const double up = std::max(1.0, pct_start * double(total_steps));
+        const double s = std::min(double(step), double(total_steps - 1));
+        auto cosine = [](double from, double to, double progress) {
+            return to + (from - to) * 0.5 * (1.0 + std::cos(std::acos(-1.0) * progress));
+        };
+        const double start = 1.0 / div_factor, end = 1.0 / final_div;
+        const double factor = s < up ? cosine(start, 1.0, s / up)
+                                     : cosine(1.0, end, (s - up) / std::max(1.0, double(total_steps - 1) - up));
+        return base * static_cast<T>(factor);
+    }
+};
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_SCHEDULE_H
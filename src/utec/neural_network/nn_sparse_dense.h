@@ -0,0 +1,193 @@
+//
+// Capa densa con pesos dispersos en formato CSR.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_SPARSE_DENSE_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_SPARSE_DENSE_H
+
+#include "nn_interfaces.h"
+#include "nn_dense.h"
+#include "../algebra/tensor.h"
+#include <vector>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+namespace utec {
+namespace neural_network {
+
+// Los pesos (in_f x out_f) se guardan por fila de entrada: para cada entrada
+// k, las columnas de salida con peso distinto de cero. Así el forward recorre
+// solo las entradas no nulas de x (la mayoría de pixeles de MNIST son cero)
+// y, por cada una, solo sus pesos vivos. El patrón de ceros queda fijo: los
+// valores se entrenan como un tensor 1 x nnz.
+template<typename T>
+class SparseDense final : public ILayer<T> {
+private:
+    size_t in_f_ = 0, out_f_ = 0;
+    std::vector<uint32_t> row_ptr_;   // in_f + 1
+    std::vector<uint32_t> cols_;      // nnz
+    utec::algebra::Tensor<T, 2> values;
+    utec::algebra::Tensor<T, 2> biases;
+    utec::algebra::Tensor<T, 2> input;
+    utec::algebra::Tensor<T, 2> grad_v;
+    utec::algebra::Tensor<T, 2> grad_b;
+    bool accumulate_ = false;
+
+public:
+    SparseDense() : row_ptr_(1, 0), values(1, 0), biases(1, 0), input(1, 0), grad_v(1, 0), grad_b(1, 0) {}
+
+    // Copia los pesos no nulos de un Dense (típicamente ya podado).
+    explicit SparseDense(const Dense<T>& dense) : SparseDense() {
+        in_f_ = dense.in_features();
+        out_f_ = dense.out_features();
+        const T* w = dense.weights_data();
+        std::vector<T> vals;
+        row_ptr_.assign(in_f_ + 1, 0);
+        for (size_t k = 0; k < in_f_; ++k) {
+            for (size_t j = 0; j < out_f_; ++j) {
+                if (w[k * out_f_ + j] != T(0)) {
+                    cols_.push_back(static_cast<uint32_t>(j));
+                    vals.push_back(w[k * out_f_ + j]);
+                }
+            }
+            row_ptr_[k + 1] = static_cast<uint32_t>(cols_.size());
+        }
+        values = utec::algebra::Tensor<T, 2>(1, vals.size());
+        std::copy(vals.begin(), vals.end(), values.begin());
+        biases = utec::algebra::Tensor<T, 2>(1, out_f_);
+        std::copy(dense.biases_data(), dense.biases_data() + out_f_, biases.begin());
+        grad_v = utec::algebra::Tensor<T, 2>(1, vals.size());
+        grad_b = utec::algebra::Tensor<T, 2>(1, out_f_);
+    }
+
+    utec::algebra::Tensor<T, 2> forward(const utec::algebra::Tensor<T, 2>& x) override {
+        input = x;
+        return infer(x);
+    }
+
+    utec::algebra::Tensor<T, 2> infer(const utec::algebra::Tensor<T, 2>& x) const override {
+        if (x.shape()[1] != in_f_) {
+            throw std::runtime_error("Matrix dimensions are incompatible for multiplication");
+        }
+        const size_t rows = x.shape()[0];
+        utec::algebra::Tensor<T, 2> out(rows, out_f_);
+        const T* vals = values.data.data();
+        for (size_t i = 0; i < rows; ++i) {
+            T* o = &out(i, 0);
+            std::copy(biases.cbegin(), biases.cend(), o);
+            const T* a_row = &x(i, 0);
+            for (size_t k = 0; k < in_f_; ++k) {
+                const T a = a_row[k];
+                if (a == T(0)) continue;
+                for (uint32_t p = row_ptr_[k]; p < row_ptr_[k + 1]; ++p)
+                    o[cols_[p]] += a * vals[p];
+            }
+        }
+        return out;
+    }
+
+    utec::algebra::Tensor<T, 2> backward(const utec::algebra::Tensor<T, 2>& dZ) override {
+        const size_t rows = dZ.shape()[0];
+        const T* vals = values.data.data();
+        if (!accumulate_) {
+            grad_v.fill(T(0));
+            grad_b.fill(T(0));
+        }
+        utec::algebra::Tensor<T, 2> dX(rows, in_f_);
+        for (size_t i = 0; i < rows; ++i) {
+            const T* dz = &dZ(i, 0);
+            const T* a_row = &input(i, 0);
+            T* dx = &dX(i, 0);
+            for (size_t j = 0; j < out_f_; ++j) grad_b(0, j) += dz[j];
+            for (size_t k = 0; k < in_f_; ++k) {
+                const T a = a_row[k];
+                T sum = T(0);
+                for (uint32_t p = row_ptr_[k]; p < row_ptr_[k + 1]; ++p) {
+                    grad_v.data[p] += a * dz[cols_[p]];
+                    sum += vals[p] * dz[cols_[p]];
+                }
+                dx[k] = sum;
+            }
+        }
+        return dX;
+    }
+
+    void clear_cache() override {
+        input = utec::algebra::Tensor<T, 2>(0, 0);
+    }
+
+    void set_accumulate_gradients(bool accumulate) override {
+        accumulate_ = accumulate;
+    }
+
+    void update_params(IOptimizer<T>& optimizer) override {
+        optimizer.update(values, grad_v, ParamKind::Weight);
+        optimizer.update(biases, grad_b, ParamKind::Bias);
+    }
+
+    std::vector<utec::algebra::Tensor<T, 2>*> parameters() override {
+        return {&values, &biases};
+    }
+
+    void save(std::ostream& out) const {
+        out << in_f_ << " " << out_f_ << " " << nnz() << "\n";
+        for (uint32_t r : row_ptr_) out << r << " ";
+        out << "\n";
+        for (uint32_t c : cols_) out << c << " ";
+        out << "\n";
+        for (const T& v : values.data) out << v << " ";
+        out << "\n";
+        for (const T& b : biases.data) out << b << " ";
+        out << "\n";
+    }
+
+    void load(std::istream& in) {
+        size_t nnz = 0;
+        in >> in_f_ >> out_f_ >> nnz;
+        row_ptr_.assign(in_f_ + 1, 0);
+        cols_.assign(nnz, 0);
+        values = utec::algebra::Tensor<T, 2>(1, nnz);
+        biases = utec::algebra::Tensor<T, 2>(1, out_f_);
+        for (auto& r : row_ptr_) in >> r;
+        for (auto& c : cols_) in >> c;
+        for (auto& v : values) in >> v;
+        for (auto& b : biases) in >> b;
+        if (!in || row_ptr_.back() != nnz) {
+            throw std::runtime_error("Corrupt SparseDense layer");
+        }
+        for (uint32_t c : cols_) {
+            if (c >= out_f_) throw std::runtime_error("Corrupt SparseDense layer");
+        }
+        grad_v = utec::algebra::Tensor<T, 2>(1, nnz);
+        grad_b = utec::algebra::Tensor<T, 2>(1, out_f_);
+    }
+
+    // Vuelve a la representación densa (in_f x out_f).
+    Dense<T> to_dense() const {
+        std::vector<T> w(in_f_ * out_f_, T(0));
+        for (size_t k = 0; k < in_f_; ++k)
+            for (uint32_t p = row_ptr_[k]; p < row_ptr_[k + 1]; ++p)
+                w[k * out_f_ + cols_[p]] = values.data[p];
+        Dense<T> dense(0, 0, [](auto&){}, [](auto&){});
+        dense.assign(w.data(), in_f_, out_f_, biases.data.data());
+        return dense;
+    }
+
+    size_t in_features() const noexcept { return in_f_; }
+    size_t out_features() const noexcept { return out_f_; }
+    size_t nnz() const noexcept { return cols_.size(); }
+    double sparsity() const noexcept {
+        return (in_f_ != 0 && out_f_ != 0) ? 1.0 - double(nnz()) / double(in_f_ * out_f_) : 0.0;
+    }
+    // Bytes de pesos: índices de fila y columna más valores y sesgos.
+    size_t size_bytes() const noexcept {
+        return (row_ptr_.size() + cols_.size()) * sizeof(uint32_t) + (nnz() + out_f_) * sizeof(T);
+    }
+};
+
+} // namespace neural_network
+} // namespace utec
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_SPARSE_DENSE_H
@@ -0,0 +1,337 @@
+//
+// Barrido de hiperparámetros dentro de un solo proceso.
+//
+// El dataset se carga una vez y todas las configuraciones lo leen sin
+// copiarlo (train solo copia cada batch). Cada configuración entrena su
+// propia NeuralNetwork como una tarea de un pool con robo de trabajo, y
+// successive halving (Jamieson y Talwalkar, 2016) corta las peores: en cada
+// ronda sigue 1/eta de las configuraciones y las que quedan entrenan hasta
+// eta veces más épocas.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_SWEEP_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_SWEEP_H
+
+#include "neural_network.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace utec::neural_network {
+
+template<typename T>
+struct SweepTrial {
+    // Configuración
+    size_t id = 0;
+    T learning_rate = T(0.01);
+    size_t batch_size = 64;
+    std::vector<size_t> hidden;   // anchos de las capas ocultas
+
+    // Resultado (épocas acumuladas y métricas de validación de la última
+    // ronda que alcanzó)
+    size_t epochs = 0;
+    size_t rung = 0;
+    T train_loss = T(0);
+    T validation_loss = T(0);
+    double accuracy = 0.0;
+    double seconds = 0.0;
+    bool finished = false;        // sobrevivió a todas las rondas
+    std::string error;
+};
+
+// Producto cartesiano de tasas, tamaños de batch y capas ocultas.
+template<typename T>
+std::vector<SweepTrial<T>> sweep_grid(const std::vector<T>& learning_rates, const std::vector<size_t>& batch_sizes,
+                                      const std::vector<std::vector<size_t>>& hidden) {
+    std::vector<SweepTrial<T>> trials;
+    for (const auto& layers : hidden)
+        for (size_t batch : batch_sizes)
+            for (T rate : learning_rates) {
+                SweepTrial<T> trial;
+                trial.id = trials.size();
+                trial.learning_rate = rate;
+                trial.batch_size = batch;
+                trial.hidden = layers;
+                trials.push_back(trial);
+            }
+    return trials;
+}
+
+struct SweepOptions {
+    size_t workers = 0;      // 0: todos los núcleos
+    size_t rungs = 3;        // rondas de successive halving (1: sin cortes)
+    size_t min_epochs = 1;   // épocas acumuladas al cerrar la primera ronda
+    size_t eta = 3;          // sigue 1/eta; la ronda siguiente llega a eta veces las épocas
+};
+
+// Ejecuta todas las tareas en `workers` hilos (el que llama es uno de
+// ellos). Cada hilo tiene su cola y la recorre desde el principio; cuando se
+// vacía, roba del final de otra. Conviene pasar las tareas de mayor a menor
+// costo: cada hilo empieza por las largas y los ladrones se llevan las
+// cortas, que son las que mejor rellenan. Las tareas no crean tareas, así
+// que un hilo que encuentra todas las colas vacías ya terminó. Las tareas no
+// deben lanzar excepciones.
+inline void run_work_stealing(const std::vector<std::function<void()>>& tasks, size_t workers = 0) {
+    if (tasks.empty()) return;
+    if (workers == 0) workers = std::max(1u, std::thread::hardware_concurrency());
+    workers = std::min(workers, tasks.size());
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<size_t> items;
+    };
+    std::vector<Queue> queues(workers);
+    for (size_t i = 0; i < tasks.size(); ++i) queues[i % workers].items.push_back(i);
+
+    auto work = [&](size_t w) {
+        while (true) {
+            size_t task = tasks.size();
+            for (size_t k = 0; k < workers && task == tasks.size(); ++k) {
+                auto& queue = queues[(w + k) % workers];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.items.empty()) continue;
+                if (k == 0) {
+                    task = queue.items.front();
+                    queue.items.pop_front();
+                } else {
+                    task = queue.items.back();
+                    queue.items.pop_back();
+                }
+            }
+            if (task == tasks.size()) return;
+            tasks[task]();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t w = 1; w < workers; ++w) threads.emplace_back(work, w);
+    work(0);
+    for (auto& t : threads) t.join();
+}
+
+// Los tensores no se copian: deben vivir mientras se usa el runner, y como
+// solo se leen, todas las tareas los comparten.
+template<typename T>
+class SweepRunner {
+public:
+    using Builder = std::function<NeuralNetwork<T>(const SweepTrial<T>&)>;
+
+private:
+    const algebra::Tensor<T, 2>& X_;
+    const algebra::Tensor<T, 2>& Y_;
+    const algebra::Tensor<T, 2>& X_val_;
+    const algebra::Tensor<T, 2>& Y_val_;
+    Builder build_;
+    std::unique_ptr<NeuralNetwork<T>> best_;
+
+    // Multiplicaciones por fila de un MLP con esas capas ocultas: para
+    // ordenar las tareas antes de construir las redes.
+    size_t cost_per_epoch(const SweepTrial<T>& trial) const {
+        size_t in = X_.shape()[1], macs = 0;
+        for (size_t width : trial.hidden) {
+            macs += in * width;
+            in = width;
+        }
+        return macs + in * Y_.shape()[1];
+    }
+
+    // Argmax por fila; con una sola salida, umbral 0.5.
+    static double accuracy(const algebra::Tensor<T, 2>& P, const algebra::Tensor<T, 2>& Y) {
+        const size_t rows = P.shape()[0], cols = P.shape()[1];
+        if (rows == 0) return 0.0;
+        size_t correct = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            const T* p = P.data.data() + i * cols;
+            const T* y = Y.data.data() + i * cols;
+            if (cols == 1) {
+                correct += (p[0] > T(0.5)) == (y[0] > T(0.5));
+            } else {
+                correct += std::max_element(p, p + cols) - p == std::max_element(y, y + cols) - y;
+            }
+        }
+        return static_cast<double>(correct) / static_cast<double>(rows);
+    }
+
+    // Para ordenar por pérdida de validación: NaN y errores al final.
+    static bool better(const SweepTrial<T>& a, const SweepTrial<T>& b) {
+        const bool a_ok = a.error.empty() && !std::isnan(a.validation_loss);
+        const bool b_ok = b.error.empty() && !std::isnan(b.validation_loss);
+        if (a_ok != b_ok) return a_ok;
+        return a.validation_loss < b.validation_loss;
+    }
+
+public:
+    SweepRunner(const algebra::Tensor<T, 2>& X, const algebra::Tensor<T, 2>& Y,
+                const algebra::Tensor<T, 2>& X_val, const algebra::Tensor<T, 2>& Y_val, Builder build)
+        : X_(X), Y_(Y), X_val_(X_val), Y_val_(Y_val), build_(std::move(build)) {
+        if (X.shape()[0] != Y.shape()[0] || X_val.shape()[0] != Y_val.shape()[0]) {
+            throw std::runtime_error("Sweep inputs and targets have different sizes");
+        }
+        if (X.shape()[1] != X_val.shape()[1] || Y.shape()[1] != Y_val.shape()[1]) {
+            throw std::runtime_error("Sweep training and validation shapes differ");
+        }
+    }
+
+    // Entrena las configuraciones por rondas y devuelve todas ordenadas: las
+    // que terminaron primero, después por ronda alcanzada y pérdida de
+    // validación. Cada red sigue entrenando desde donde quedó (con su
+    // optimizador), y las descartadas se liberan al cerrar su ronda.
+    template<
+        template <typename...> class LossType,
+        template <typename...> class OptimizerType = SGD
+    >
+    std::vector<SweepTrial<T>> run(std::vector<SweepTrial<T>> trials, const SweepOptions& options = {}) {
+        if (options.rungs == 0 || options.min_epochs == 0 || options.eta < 2) {
+            throw std::runtime_error("Invalid sweep options");
+        }
+        best_.reset();
+        std::vector<std::unique_ptr<NeuralNetwork<T>>> networks(trials.size());
+        std::vector<size_t> alive(trials.size());
+        std::iota(alive.begin(), alive.end(), size_t(0));
+
+        size_t budget = options.min_epochs;
+        for (size_t rung = 0; rung < options.rungs && !alive.empty(); ++rung) {
+            std::sort(alive.begin(), alive.end(), [&](size_t a, size_t b) {
+                return cost_per_epoch(trials[a]) * (budget - trials[a].epochs) >
+                       cost_per_epoch(trials[b]) * (budget - trials[b].epochs);
+            });
+            std::vector<std::function<void()>> tasks;
+            for (size_t i : alive) {
+                tasks.push_back([&, i, budget, rung] {
+                    auto& trial = trials[i];
+                    const auto start = std::chrono::steady_clock::now();
+                    try {
+                        if (!networks[i]) networks[i] = std::make_unique<NeuralNetwork<T>>(build_(trial));
+                        auto& nn = *networks[i];
+                        nn.template train<LossType, OptimizerType>(X_, Y_, budget - trial.epochs, trial.batch_size,
+                                                                   trial.learning_rate);
+                        trial.epochs = budget;
+                        trial.rung = rung;
+                        if (!nn.history().empty()) trial.train_loss = nn.history().back().train_loss;
+                        const auto predictions = nn.predict(X_val_);
+                        trial.validation_loss = LossType<T>(predictions, Y_val_).loss();
+                        trial.accuracy = accuracy(predictions, Y_val_);
+                    } catch (const std::exception& e) {
+                        trial.error = e.what();
+                        networks[i].reset();
+                    } catch (...) {
+                        trial.error = "unknown error";
+                        networks[i].reset();
+                    }
+                    trial.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                });
+            }
+            run_work_stealing(tasks, options.workers);
+
+            std::vector<size_t> survivors;
+            for (size_t i : alive)
+                if (trials[i].error.empty()) survivors.push_back(i);
+            std::stable_sort(survivors.begin(), survivors.end(),
+                             [&](size_t a, size_t b) { return better(trials[a], trials[b]); });
+            const bool last = rung + 1 == options.rungs;
+            const size_t keep = last ? survivors.size() : std::max<size_t>(1, survivors.size() / options.eta);
+            for (size_t k = keep; k < survivors.size(); ++k) networks[survivors[k]].reset();
+            survivors.resize(std::min(keep, survivors.size()));
+            alive = std::move(survivors);
+            budget *= options.eta;
+        }
+
+        for (size_t i : alive) trials[i].finished = true;
+        if (!alive.empty()) best_ = std::move(networks[alive.front()]);
+
+        std::stable_sort(trials.begin(), trials.end(), [](const SweepTrial<T>& a, const SweepTrial<T>& b) {
+            if (a.finished != b.finished) return a.finished;
+            if (a.rung != b.rung) return a.rung > b.rung;
+            return better(a, b);
+        });
+        return trials;
+    }
+
+    // Red de la mejor configuración del último run (nullptr si ninguna
+    // terminó).
+    NeuralNetwork<T>* best() noexcept {
+        return best_.get();
+    }
+};
+
+// Builder para SweepRunner: MLP con las capas ocultas de la configuración
+// (Dense + ReLU, pesos He), salida Dense + Sigmoid (Xavier). Los pesos de
+// cada configuración salen de su propio flujo, así que no dependen del orden
+// en que el pool las construye.
+template<typename T>
+typename SweepRunner<T>::Builder sweep_mlp(size_t inputs, size_t outputs, uint64_t seed = 2025) {
+    return [=](const SweepTrial<T>& trial) {
+        const rng::Stream stream = rng::Stream(seed).split(trial.id);
+        auto zero = [](algebra::Tensor<T, 2>& b) { b.fill(T(0)); };
+        NeuralNetwork<T> nn;
+        size_t in = inputs, layer = 0;
+        for (size_t width : trial.hidden) {
+            nn.add_layer(std::make_unique<Dense<T>>(in, width, rng::he_uniform(stream.split(layer++), 1), zero));
+            nn.add_layer(std::make_unique<ReLU<T>>());
+            in = width;
+        }
+        nn.add_layer(std::make_unique<Dense<T>>(in, outputs, rng::xavier_uniform(stream.split(layer), 1), zero));
+        nn.add_layer(std::make_unique<Sigmoid<T>>());
+        return nn;
+    };
+}
+
+// Tabla de resultados con columnas alineadas, o CSV con csv = true.
+template<typename T>
+void write_sweep_table(std::ostream& out, const std::vector<SweepTrial<T>>& trials, bool csv = false) {
+    const std::vector<std::pair<const char*, int>> columns = {
+        {"id", 5}, {"tasa", 10}, {"batch", 7}, {"capas", 14}, {"epocas", 8}, {"ronda", 7},
+        {"perdida", 11}, {"validacion", 12}, {"exactitud", 11}, {"segundos", 10}, {"estado", 0}};
+    auto cell = [&](size_t c, const std::string& text) {
+        if (csv) {
+            out << (c ? "," : "") << text;
+        } else {
+            out << (c + 1 == columns.size() ? "  " : "") << std::setw(columns[c].second) << text;
+        }
+    };
+    auto number = [](double value, int precision) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(precision) << value;
+        return s.str();
+    };
+
+    for (size_t c = 0; c < columns.size(); ++c) cell(c, columns[c].first);
+    out << "\n";
+    for (const auto& trial : trials) {
+        std::string layers;
+        for (size_t width : trial.hidden) layers += (layers.empty() ? "" : "x") + std::to_string(width);
+        std::string state = trial.finished ? "completa" : "descartada";
+        if (!trial.error.empty()) state = "error: " + trial.error;
+        if (csv) state = "\"" + state + "\"";
+
+        std::ostringstream rate;
+        rate << trial.learning_rate;
+        cell(0, std::to_string(trial.id));
+        cell(1, rate.str());
+        cell(2, std::to_string(trial.batch_size));
+        cell(3, layers.empty() ? "-" : layers);
+        cell(4, std::to_string(trial.epochs));
+        cell(5, std::to_string(trial.rung));
+        cell(6, number(trial.train_loss, 5));
+        cell(7, number(trial.validation_loss, 5));
+        cell(8, number(trial.accuracy, 4));
+        cell(9, number(trial.seconds, 2));
+        cell(10, state);
+        out << "\n";
+    }
+}
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_SWEEP_H
@@ -0,0 +1,69 @@
+//
+// Seguimiento por época del entrenamiento: pérdida promedio, validación,
+// callbacks y parada temprana.
+//
+
+#ifndef PROG3_NN_FINAL_PROJECT_V2025_01_TRAINING_H
+#define PROG3_NN_FINAL_PROJECT_V2025_01_TRAINING_H
+
+#include <cstddef>
+#include <limits>
+#include <functional>
+#include <stdexcept>
+
+namespace utec::neural_network {
+
+template<typename T>
+struct EpochStats {
+    size_t epoch = 0;            // épocas completas hasta ahora (1 = la primera)
+    T train_loss = T(0);         // promedio por muestra de las pérdidas de cada batch
+    size_t samples = 0;
+    T learning_rate = T(0);      // tasa del último paso de la época
+    bool validated = false;      // hubo validación en esta época
+    T validation_loss = T(0);
+    double seconds = 0.0;
+};
+
+// Devuelve false para detener el entrenamiento al terminar la época.
+template<typename T>
+using EpochCallback = std::function<bool(const EpochStats<T>&)>;
+
+// Se detiene tras `patience` evaluaciones sin mejorar al menos `min_delta`.
+// Vigila la pérdida de validación si hay conjunto de validación; si no, la
+// de entrenamiento. Con restore_best, al detenerse vuelve a los pesos de la
+// mejor época.
+struct EarlyStopping {
+    size_t patience = 5;
+    double min_delta = 1e-4;
+    bool restore_best = true;
+
+    double best = std::numeric_limits<double>::infinity();
+    size_t best_epoch = 0;
+    size_t waiting = 0;
+
+    EarlyStopping() = default;
+    EarlyStopping(size_t patience, double min_delta = 1e-4, bool restore_best = true)
+        : patience(patience), min_delta(min_delta), restore_best(restore_best) {
+        if (patience == 0) {
+            throw std::runtime_error("Early stopping patience must be positive");
+        }
+    }
+
+    // Registra un valor; true si es la mejor época hasta ahora.
+    bool observe(double value, size_t epoch) {
+        if (value < best - min_delta) {
+            best = value;
+            best_epoch = epoch;
+            waiting = 0;
+            return true;
+        }
+        ++waiting;
+        return false;
+    }
+
+    bool should_stop() const noexcept { return waiting >= patience; }
+};
+
+} // namespace utec::neural_network
+
+#endif //PROG3_NN_FINAL_PROJECT_V2025_01_TRAINING_H
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <random>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+// 16 bloques Dense + ReLU (uno con BatchNorm): 33 capas + Sigmoid.
+NeuralNetwork<float> make_network(uint32_t seed) {
+    mt19937 gen(seed);
+    uniform_real_distribution<float> dist(-0.1f, 0.1f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+    NeuralNetwork<float> nn;
+    size_t in = 16;
+    for (size_t block = 0; block < 16; ++block) {
+        nn.add_layer(make_unique<Dense<float>>(in, 256, init, init));
+        if (block == 3) nn.add_layer(make_unique<BatchNorm<float>>(256));
+        nn.add_layer(make_unique<ReLU<float>>());
+        in = 256;
+    }
+    nn.add_layer(make_unique<Dense<float>>(in, 1, init, init));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+    return nn;
+}
+
+int64_t peak_during(NeuralNetwork<float>& nn, const Tensor<float, 2>& X, const Tensor<float, 2>& Y) {
+    telemetry::reset();
+    const int64_t before = telemetry::totals().live_bytes;
+    nn.train<BCELoss, SGD>(X, Y, 1, 256, 0.05f);
+    return telemetry::totals().peak_bytes - before;
+}
+
+} // namespace
+
+// Compilado con UTEC_TENSOR_TELEMETRY (con SGD, sin estado del optimizador
+// que enturbie el pico): el checkpointing de activaciones da
+// exactamente los mismos pesos y estadísticas (el recálculo es determinista
+// y no vuelve a mover las de BatchNorm) con menos memoria pico.
+int main() {
+    mt19937 gen(48);
+    normal_distribution<float> noise(0.0f, 1.0f);
+    Tensor<float, 2> X(512, 16), Y(512, 1);
+    for (size_t i = 0; i < 512; ++i) {
+        for (size_t j = 0; j < 16; ++j) X(i, j) = noise(gen);
+        Y(i, 0) = X(i, 0) > 0.0f ? 1.0f : 0.0f;
+    }
+
+    auto plain = make_network(1);
+    auto checkpointed = make_network(1);
+    checkpointed.enable_activation_checkpointing();
+    const int64_t peak_plain = peak_during(plain, X, Y);
+    const int64_t peak_checkpointed = peak_during(checkpointed, X, Y);
+    cout << "Pico sin checkpointing: " << peak_plain / 1024 << " KB, con: " << peak_checkpointed / 1024 << " KB\n";
+
+    for (size_t l = 0; l < plain.dlayers().size(); ++l) {
+        auto a = plain.dlayers()[l]->parameters(), b = checkpointed.dlayers()[l]->parameters();
+        auto ba = plain.dlayers()[l]->buffers(), bb = checkpointed.dlayers()[l]->buffers();
+        a.insert(a.end(), ba.begin(), ba.end());
+        b.insert(b.end(), bb.begin(), bb.end());
+        for (size_t p = 0; p < a.size(); ++p)
+            if (a[p]->data != b[p]->data) {
+                cerr << "FALLO: la capa " << l << " difiere con checkpointing" << endl;
+                return 1;
+            }
+    }
+    if (!(peak_checkpointed * 2 < peak_plain)) {
+        cerr << "FALLO: el checkpointing no bajó el pico de memoria" << endl;
+        return 1;
+    }
+
+    // Segmentos de tamaño fijo, incluso uno por capa.
+    auto single = make_network(1);
+    single.enable_activation_checkpointing(1);
+    peak_during(single, X, Y);
+    if (single.dlayers()[0]->parameters()[0]->data != plain.dlayers()[0]->parameters()[0]->data) {
+        cerr << "FALLO: segmentos de una capa" << endl;
+        return 1;
+    }
+    cout << "OK" << endl;
+    return 0;
+}
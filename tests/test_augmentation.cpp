@@ -0,0 +1,91 @@
+#include <iostream>
+#include <cstring>
+#include <numeric>
+#include "utec/neural_network/neural_network.h"
+#include "utec/neural_network/data/augmentation.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// AugmentationPipeline: la salida es la misma, byte por byte, con 1 worker
+// que con varios (llamada a llamada), cambia las imágenes, y wrap() aplica
+// lo mismo dentro del hilo de prefetch. Un borde brillante que una
+// traslación saca de la imagen, hacia cualquier lado, lee ceros fuera de ella
+// en vez de repetirse.
+int main() {
+    const size_t rows = 37, image = 784;
+    vector<float> source(rows * image, 0.0f);
+    const rng::Stream stream(28);
+    for (size_t r = 0; r < rows; ++r)
+        for (size_t k = 0; k < 120; ++k) source[r * image + 200 + stream.below(r * 120 + k, 400)] = 1.0f;
+
+    AugmentationPipeline<float> serial({}, 1, 5), parallel({}, 4, 5), other_seed({}, 4, 6);
+    for (int call = 0; call < 3; ++call) {
+        vector<float> a = source, b = source, c = source;
+        serial(a.data(), rows);
+        parallel(b.data(), rows);
+        other_seed(c.data(), rows);
+        if (memcmp(a.data(), b.data(), a.size() * sizeof(float)) != 0) {
+            cerr << "FALLO: la salida depende del número de workers (llamada " << call << ")" << endl;
+            return 1;
+        }
+        if (a == source || a == c) {
+            cerr << "FALLO: el aumento no cambia las imágenes o ignora la semilla" << endl;
+            return 1;
+        }
+        for (float v : a)
+            if (!(v >= 0.0f && v <= 1.0f)) {
+                cerr << "FALLO: valor fuera de rango " << v << endl;
+                return 1;
+            }
+    }
+
+    // Mismo aumento dentro del PrefetchLoader: el batch 0 coincide con
+    // aplicar una pipeline nueva al batch sin aumentar.
+    auto gather = [&](const size_t* indices, size_t n, float* x, float* y) {
+        for (size_t r = 0; r < n; ++r) {
+            copy_n(source.data() + indices[r] * image, image, x + r * image);
+            y[r] = float(indices[r]);
+        }
+    };
+    AugmentationPipeline<float> inside({}, 3, 5), reference({}, 2, 5);
+    PrefetchLoader<float> loader(rows, image, 1, 16, inside.wrap(gather), 2, false);
+    const auto* batch = loader.next();
+    vector<float> expected(source.begin(), source.begin() + 16 * image);
+    reference(expected.data(), 16);
+    if (!batch || memcmp(batch->x.data.data(), expected.data(), expected.size() * sizeof(float)) != 0) {
+        cerr << "FALLO: wrap() no aplica el mismo aumento" << endl;
+        return 1;
+    }
+
+    // Solo traslación: la bilineal reparte cada pixel sin crear masa, así que
+    // la suma de la salida nunca supera la de la entrada. Si fuera de rango se
+    // repitiera el borde, la línea brillante se estiraría varias columnas.
+    AugmentConfig shift_only;
+    shift_only.max_shift = 6.0f;
+    shift_only.max_rotation = 0.0f;
+    shift_only.min_scale = shift_only.max_scale = 1.0f;
+    shift_only.elastic_alpha = 0.0f;
+    AugmentationPipeline<float> shifter(shift_only, 1, 7);
+    const char* edges[] = {"izquierdo", "derecho", "superior", "inferior"};
+    for (size_t edge = 0; edge < 4; ++edge) {
+        vector<float> line(rows * image, 0.0f);
+        for (size_t r = 0; r < rows; ++r)
+            for (size_t k = 0; k < 28; ++k) {
+                const size_t x = edge == 0 ? 0 : edge == 1 ? 27 : k, y = edge == 2 ? 0 : edge == 3 ? 27 : k;
+                line[r * image + y * 28 + x] = 1.0f;
+            }
+        shifter(line.data(), rows);
+        for (size_t r = 0; r < rows; ++r) {
+            const float sum = accumulate(line.begin() + r * image, line.begin() + (r + 1) * image, 0.0f);
+            if (sum > 28.0f + 1e-3f) {
+                cerr << "FALLO: el borde " << edges[edge] << " se repite fuera de la imagen (suma " << sum << ")" << endl;
+                return 1;
+            }
+        }
+    }
+
+    cout << "Augmentation OK" << endl;
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <iostream>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+double probe(BatchNorm<double>& bn, const Tensor<double, 2>& X, const Tensor<double, 2>& weights) {
+    const auto out = bn.forward(X);
+    double sum = 0.0;
+    for (size_t i = 0; i < out.size(); ++i) sum += out.data[i] * weights.data[i];
+    return sum;
+}
+
+} // namespace
+
+// Gradiente de BatchNorm contra diferencias finitas (también con una fila,
+// que usa las estadísticas móviles), estadísticas móviles, save/load, el
+// plegado en el Dense anterior y un último batch de una fila al entrenar.
+int main() {
+    mt19937 gen(46);
+    {
+        uniform_real_distribution<double> dist(-1.0, 1.0);
+        Tensor<double, 2> X(6, 5), weights(6, 5);
+        for (auto& v : X) v = 3.0 * dist(gen) + 2.0;
+        for (auto& v : weights) v = dist(gen);
+        BatchNorm<double> bn(5);
+        auto params = bn.parameters();
+        for (auto& v : *params[0]) v = 1.0 + dist(gen);
+        for (auto& v : *params[1]) v = dist(gen);
+
+        bn.forward(X);
+        const auto dX = bn.backward(weights);
+        for (size_t i = 0; i < X.size(); ++i) {
+            const double saved = X.data[i];
+            X.data[i] = saved + 1e-6;
+            const double up = probe(bn, X, weights);
+            X.data[i] = saved - 1e-6;
+            const double down = probe(bn, X, weights);
+            X.data[i] = saved;
+            const double numeric = (up - down) / 2e-6;
+            if (fabs(numeric - dX.data[i]) > 1e-5 * max(1.0, fabs(numeric))) {
+                cerr << "FALLO: gradiente de BatchNorm en " << i << ": " << dX.data[i] << " vs " << numeric << endl;
+                return 1;
+            }
+        }
+
+        // Una fila: igual que infer, sin mover las estadísticas móviles.
+        Tensor<double, 2> row(1, 5), row_weights(1, 5);
+        for (auto& v : row) v = 3.0 * dist(gen) + 2.0;
+        for (auto& v : row_weights) v = dist(gen);
+        const auto stats = bn.buffers();
+        const auto mean_before = stats[0]->data, var_before = stats[1]->data;
+        const auto out = bn.forward(row), expected = bn.infer(row);
+        for (size_t j = 0; j < 5; ++j)
+            if (fabs(out.data[j] - expected.data[j]) > 1e-12) {
+                cerr << "FALLO: BatchNorm con una fila no usa las estadísticas móviles" << endl;
+                return 1;
+            }
+        if (stats[0]->data != mean_before || stats[1]->data != var_before) {
+            cerr << "FALLO: una fila movió las estadísticas móviles" << endl;
+            return 1;
+        }
+        const auto dRow = bn.backward(row_weights);
+        for (size_t j = 0; j < 5; ++j) {
+            const double saved = row.data[j];
+            row.data[j] = saved + 1e-6;
+            const double up = probe(bn, row, row_weights);
+            row.data[j] = saved - 1e-6;
+            const double down = probe(bn, row, row_weights);
+            row.data[j] = saved;
+            const double numeric = (up - down) / 2e-6;
+            if (fabs(numeric - dRow.data[j]) > 1e-5 * max(1.0, fabs(numeric))) {
+                cerr << "FALLO: gradiente de BatchNorm con una fila en " << j << endl;
+                return 1;
+            }
+        }
+    }
+
+    // Red con BatchNorm tras cada Dense oculto; entradas muy desplazadas.
+    uniform_real_distribution<float> dist(-0.5f, 0.5f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+    Tensor<float, 2> X(256, 4), Y(256, 1);
+    normal_distribution<float> noise(0.0f, 1.0f);
+    for (size_t i = 0; i < 256; ++i) {
+        for (size_t j = 0; j < 4; ++j) X(i, j) = 10.0f + 5.0f * noise(gen);
+        Y(i, 0) = X(i, 0) - X(i, 1) > 0.0f ? 1.0f : 0.0f;
+    }
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Dense<float>>(4, 16, init, init));
+    nn.add_layer(make_unique<BatchNorm<float>>(16));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<Dense<float>>(16, 1, init, init));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+    nn.train<BCELoss, SGD>(X, Y, 40, 32, 0.5f);
+
+    // predict usa las estadísticas móviles: dos llamadas dan lo mismo y
+    // una sola fila también funciona.
+    const auto predictions = nn.predict(X);
+    Tensor<float, 2> first(1, 4);
+    for (size_t j = 0; j < 4; ++j) first(0, j) = X(0, j);
+    if (nn.predict(X).data != predictions.data || fabs(nn.predict(first)(0, 0) - predictions(0, 0)) > 1e-5f) {
+        cerr << "FALLO: predict depende del batch" << endl;
+        return 1;
+    }
+    size_t correct = 0;
+    for (size_t i = 0; i < 256; ++i) correct += (predictions(i, 0) > 0.5f) == (Y(i, 0) > 0.5f);
+    if (correct < 235) {
+        cerr << "FALLO: la red con BatchNorm acierta solo " << correct << " de 256" << endl;
+        return 1;
+    }
+
+    const string path = "test_batchnorm.nn";
+    nn.save(path);
+    NeuralNetwork<float> loaded;
+    loaded.load(path);
+    NeuralNetwork<float> served;
+    served.load(path, true);
+    remove(path.c_str());
+    if (loaded.dlayers().size() != 5 || served.dlayers().size() != 4) {
+        cerr << "FALLO: capas inesperadas tras cargar" << endl;
+        return 1;
+    }
+    const auto reloaded = loaded.predict(X);
+    const auto folded = served.predict(X);
+    for (size_t i = 0; i < 256; ++i) {
+        if (fabs(reloaded(i, 0) - predictions(i, 0)) > 1e-4f || fabs(folded(i, 0) - predictions(i, 0)) > 1e-4f) {
+            cerr << "FALLO: la red cargada o plegada predice distinto en " << i << endl;
+            return 1;
+        }
+    }
+
+    // 33 filas con batch de 32: el último batch de cada época tiene una.
+    Tensor<float, 2> X_odd(33, 4), Y_odd(33, 1);
+    copy_n(X.cbegin(), X_odd.size(), X_odd.begin());
+    copy_n(Y.cbegin(), Y_odd.size(), Y_odd.begin());
+    nn.train<BCELoss, SGD>(X_odd, Y_odd, 3, 32, 0.5f);
+    if (!isfinite(nn.history().back().train_loss)) {
+        cerr << "FALLO: pérdida inválida con un batch de una fila" << endl;
+        return 1;
+    }
+
+    cout << "BatchNorm OK (" << correct << "/256)" << endl;
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include "utec/neural_network/neural_network.h"
+#include "utec/neural_network/data/prefetch_loader.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+NeuralNetwork<float> make_network() {
+    mt19937 gen(3);
+    uniform_real_distribution<float> dist(-0.5f, 0.5f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Dense<float>>(4, 8, init, init));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<Dense<float>>(8, 1, init, init));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+    return nn;
+}
+
+string read_file(const string& path) {
+    ifstream in(path, ios::binary);
+    return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+void write_file(const string& path, const string& bytes) {
+    ofstream out(path, ios::binary);
+    out.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+}
+
+template<typename Fn>
+bool throws(Fn fn) {
+    try {
+        fn();
+    } catch (const runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// Checkpoint a mitad de época y reanudación en una red nueva con un
+// PrefetchLoader mezclado: pesos y estado de Adam idénticos, bit a bit, a los
+// de una corrida sin interrumpir. Un checkpoint truncado o con bytes cambiados
+// se rechaza, y una escritura cortada (solo el .tmp) deja el anterior intacto.
+int main() {
+    const size_t rows = 100, batch_size = 8, epochs = 3;
+    mt19937 gen(11);
+    normal_distribution<float> noise(0.0f, 1.0f);
+    Tensor<float, 2> X(rows, 4), Y(rows, 1);
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < 4; ++j) X(i, j) = noise(gen);
+        Y(i, 0) = X(i, 0) - X(i, 2) > 0.0f ? 1.0f : 0.0f;
+    }
+    auto gather = [&](const size_t* idx, size_t n, float* x, float* y) {
+        for (size_t r = 0; r < n; ++r) {
+            copy_n(X.data.data() + idx[r] * 4, 4, x + r * 4);
+            y[r] = Y(idx[r], 0);
+        }
+    };
+
+    const string reference_path = "test_checkpoint_reference.ckpt", path = "test_checkpoint.ckpt";
+    auto reference = make_network();
+    {
+        PrefetchLoader<float> loader(rows, 4, 1, batch_size, gather, 2, true, 7);
+        reference.train<BCELoss, Adam>(loader, epochs, 0.01f);
+        reference.enable_checkpoints(reference_path, 0);
+        reference.checkpoint_now();
+        reference.flush_checkpoints();
+    }
+
+    // 13 batches por época: en dos épocas el único checkpoint es el del paso
+    // 17, en el batch 4 de la segunda.
+    {
+        auto interrupted = make_network();
+        interrupted.enable_checkpoints(path, 17);
+        PrefetchLoader<float> loader(rows, 4, 1, batch_size, gather, 2, true, 7);
+        interrupted.train<BCELoss, Adam>(loader, 2, 0.01f);
+        interrupted.flush_checkpoints();
+    }
+    if (filesystem::exists(path + ".tmp")) {
+        cerr << "FALLO: quedó el archivo temporal del checkpoint" << endl;
+        return 1;
+    }
+
+    const string resumed_path = "test_checkpoint_resumed.ckpt";
+    {
+        auto resumed = make_network();
+        const auto state = resumed.load_checkpoint(path);
+        if (state.epoch != 1 || state.batch != 4 || state.step != 17 || state.loader_state.empty()) {
+            cerr << "FALLO: posición inesperada (época " << state.epoch << ", batch " << state.batch << ")" << endl;
+            return 1;
+        }
+        PrefetchLoader<float> loader(rows, 4, 1, batch_size, gather, 2, true, 7, state.loader_state);
+        resumed.train<BCELoss, Adam>(loader, epochs - state.epoch, 0.01f);
+        resumed.enable_checkpoints(resumed_path, 0);
+        resumed.checkpoint_now();
+        resumed.flush_checkpoints();
+    }
+    const auto expected = checkpoint::read<float>(reference_path);
+    const auto actual = checkpoint::read<float>(resumed_path);
+    if (actual.state.step != expected.state.step || actual.params.size() != expected.params.size()) {
+        cerr << "FALLO: la reanudación dio " << actual.state.step << " pasos contra " << expected.state.step << endl;
+        return 1;
+    }
+    for (size_t t = 0; t < expected.params.size(); ++t)
+        if (actual.params[t].data != expected.params[t].data) {
+            cerr << "FALLO: el tensor " << t << " difiere de la corrida sin interrumpir" << endl;
+            return 1;
+        }
+    if (actual.optimizer_state != expected.optimizer_state) {
+        cerr << "FALLO: el estado de Adam difiere de la corrida sin interrumpir" << endl;
+        return 1;
+    }
+
+    // Truncado o con un byte cambiado: read lo rechaza.
+    const string bytes = read_file(path), broken = "test_checkpoint_broken.ckpt";
+    for (size_t cut : {size_t(2), size_t(12), bytes.size() / 2, bytes.size() - 1}) {
+        write_file(broken, bytes.substr(0, cut));
+        if (!throws([&] { checkpoint::read<float>(broken); })) {
+            cerr << "FALLO: se aceptó un checkpoint truncado a " << cut << " bytes" << endl;
+            return 1;
+        }
+    }
+    string flipped = bytes;
+    flipped[bytes.size() / 2] ^= 0x10;
+    write_file(broken, flipped);
+    if (!throws([&] { checkpoint::read<float>(broken); })) {
+        cerr << "FALLO: se aceptó un checkpoint con un byte cambiado" << endl;
+        return 1;
+    }
+
+    // Escritura cortada: el .tmp truncado no reemplaza al checkpoint bueno.
+    write_file(path + ".tmp", bytes.substr(0, bytes.size() / 3));
+    auto after_crash = make_network();
+    if (after_crash.load_checkpoint(path).step != 17) {
+        cerr << "FALLO: el .tmp truncado afectó al checkpoint" << endl;
+        return 1;
+    }
+
+    for (const auto& file : {reference_path, path, path + ".tmp", resumed_path, broken}) remove(file.c_str());
+    cout << "Checkpoint OK (" << bytes.size() << " bytes)" << endl;
+    return 0;
+}
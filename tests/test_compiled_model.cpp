@@ -0,0 +1,42 @@
+#include <iostream>
+#include <random>
+#include <cmath>
+#include "utec/neural_network/neural_network.h"
+#include "modelo_compiled.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Compara el forward generado por proyecto_final_compile contra predict.
+int main(int argc, char* argv[]) {
+    const string path = argc > 1 ? argv[1] : "modelo.nn";
+    NeuralNetwork<float> nn;
+    nn.load(path);
+
+    const size_t n = 256;
+    Tensor<float, 2> X(n, modelo_compiled::INPUT_SIZE);
+    mt19937 gen(7);
+    uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (auto& v : X) v = dist(gen);
+
+    auto expected = nn.predict(X);
+    vector<float> got(n * modelo_compiled::OUTPUT_SIZE);
+    modelo_compiled::forward_batch(X.data.data(), got.data(), n);
+
+    float max_diff = 0.0f;
+    size_t exact = 0;
+    for (size_t i = 0; i < got.size(); ++i) {
+        max_diff = max(max_diff, fabs(got[i] - expected.data[i]));
+        exact += got[i] == expected.data[i];
+    }
+    cout << "Iguales bit a bit: " << exact << "/" << got.size() << ", diferencia maxima: " << max_diff << endl;
+
+    // Con -march=native las sumas pueden fusionarse en FMA de forma distinta.
+    if (max_diff > 1e-4f) {
+        cerr << "FALLO: el modelo compilado no coincide con predict" << endl;
+        return 1;
+    }
+    cout << "OK" << endl;
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Varios hilos comparten una misma red (con y sin plan) llamando a infer e
+// infer_one a la vez; cada resultado debe ser idéntico al de un solo hilo.
+int main(int argc, char* argv[]) {
+    const string path = argc > 1 ? argv[1] : "modelo.nn";
+    NeuralNetwork<float> layered, planned;
+    layered.load(path);
+    planned.load(path, true);
+
+    const size_t rows = 32, threads = 8, iterations = 40;
+    Tensor<float, 2> X(rows, 784);
+    mt19937 gen(17);
+    uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (auto& v : X) v = dist(gen);
+    const auto expected = layered.infer(X);
+    const size_t outputs = expected.shape()[1];
+
+    atomic<size_t> mismatches{0};
+    auto worker = [&](size_t id) {
+        vector<float> y(outputs);
+        InferenceContext<float> context;
+        for (size_t it = 0; it < iterations; ++it) {
+            const size_t first = (id * 7 + it * 3) % rows;
+            const size_t n = 1 + (id + it) % 4;
+            Tensor<float, 2> x(n, 784);
+            for (size_t r = 0; r < n; ++r)
+                for (size_t k = 0; k < 784; ++k) x(r, k) = X((first + r) % rows, k);
+
+            const auto a = layered.infer(x);
+            const auto b = planned.infer(x);
+            for (size_t r = 0; r < n; ++r)
+                for (size_t j = 0; j < outputs; ++j) {
+                    const float e = expected((first + r) % rows, j);
+                    mismatches += a(r, j) != e;
+                    mismatches += b(r, j) != e;
+                }
+
+            planned.infer_one(&X(first, 0), y.data(), context);
+            for (size_t j = 0; j < outputs; ++j) mismatches += y[j] != expected(first, j);
+        }
+    };
+
+    vector<thread> pool;
+    for (size_t t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+    for (auto& t : pool) t.join();
+
+    cout << "Diferencias: " << mismatches.load() << endl;
+    if (mismatches.load() != 0) {
+        cerr << "FALLO: la inferencia concurrente no coincide" << endl;
+        return 1;
+    }
+    cout << "OK" << endl;
+    return 0;
+}
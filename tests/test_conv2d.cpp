@@ -0,0 +1,137 @@
+#include <iostream>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+// Pérdida escalar fija para comparar el backward con diferencias finitas.
+double probe(ILayer<double>& layer, const Tensor<double, 2>& X, const Tensor<double, 2>& weights) {
+    const auto out = layer.forward(X);
+    double sum = 0.0;
+    for (size_t i = 0; i < out.size(); ++i) sum += out.data[i] * weights.data[i];
+    return sum;
+}
+
+bool check_gradients(const char* name, ILayer<double>& layer, Tensor<double, 2> X, mt19937& gen) {
+    uniform_real_distribution<double> dist(-1.0, 1.0);
+    const auto out = layer.forward(X);
+    Tensor<double, 2> weights(out.shape()[0], out.shape()[1]);
+    for (auto& v : weights) v = dist(gen);
+
+    layer.forward(X);
+    const auto dX = layer.backward(weights);
+    const double eps = 1e-6;
+    for (size_t i = 0; i < X.size(); ++i) {
+        const double saved = X.data[i];
+        X.data[i] = saved + eps;
+        const double up = probe(layer, X, weights);
+        X.data[i] = saved - eps;
+        const double down = probe(layer, X, weights);
+        X.data[i] = saved;
+        const double numeric = (up - down) / (2 * eps);
+        if (fabs(numeric - dX.data[i]) > 1e-5 * max(1.0, fabs(numeric))) {
+            cerr << "FALLO: gradiente de " << name << " en " << i << ": " << dX.data[i] << " vs " << numeric << endl;
+            return false;
+        }
+    }
+    if (layer.infer(X).data != layer.forward(X).data) {
+        cerr << "FALLO: infer y forward de " << name << " difieren" << endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// Gradientes de Conv2D y pooling contra diferencias finitas, infer igual a
+// forward, y una CNN pequeña que aprende y sobrevive a save/load.
+int main() {
+    mt19937 gen(45);
+    uniform_real_distribution<float> dist(-0.5f, 0.5f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+
+    uniform_real_distribution<double> dist_d(-0.5, 0.5);
+    auto init_d = [&](Tensor<double, 2>& t) { for (auto& v : t) v = dist_d(gen); };
+    Tensor<double, 2> X(3, 2 * 7 * 6);
+    for (auto& v : X) v = dist_d(gen);
+
+    Conv2D<double> conv(2, 7, 6, 3, 3, init_d, init_d, 2, 1);
+    if (conv.out_height() != 4 || conv.out_width() != 3 || conv.output_size() != 3 * 4 * 3) {
+        cerr << "FALLO: geometría de Conv2D" << endl;
+        return 1;
+    }
+    if (!check_gradients("Conv2D", conv, X, gen)) return 1;
+
+    // Gradiente de los pesos en una posición.
+    {
+        const auto out = conv.forward(X);
+        Tensor<double, 2> ones(out.shape()[0], out.shape()[1]);
+        ones.fill(1.0);
+        conv.backward(ones);
+        SGD<double> capture(1.0);
+        auto params = conv.parameters();
+        const Tensor<double, 2> before = *params[0];
+        conv.update_params(capture);
+        const double analytic = before.data[5] - params[0]->data[5];
+        *params[0] = before;
+        auto sum_out = [&] { double s = 0; for (double v : conv.forward(X)) s += v; return s; };
+        params[0]->data[5] += 1e-6;
+        const double up = sum_out();
+        params[0]->data[5] -= 2e-6;
+        const double down = sum_out();
+        params[0]->data[5] += 1e-6;
+        if (fabs((up - down) / 2e-6 - analytic) > 1e-5 * max(1.0, fabs(analytic))) {
+            cerr << "FALLO: gradiente de los pesos de Conv2D" << endl;
+            return 1;
+        }
+    }
+
+    MaxPool2D<double> max_pool(2, 7, 6, 2, 2);
+    AvgPool2D<double> avg_pool(2, 7, 6, 3, 2);
+    if (!check_gradients("MaxPool2D", max_pool, X, gen)) return 1;
+    if (!check_gradients("AvgPool2D", avg_pool, X, gen)) return 1;
+
+    // Clasificar si la barra de una imagen 8x8 es horizontal o vertical.
+    Tensor<float, 2> images(64, 64), labels(64, 1);
+    for (size_t i = 0; i < 64; ++i) {
+        const bool vertical = i % 2;
+        const size_t line = 1 + gen() % 6;
+        for (size_t k = 0; k < 8; ++k) images(i, vertical ? k * 8 + line : line * 8 + k) = 1.0f;
+        labels(i, 0) = vertical ? 1.0f : 0.0f;
+    }
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Conv2D<float>>(1, 8, 8, 4, 3, init, init));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<MaxPool2D<float>>(4, 6, 6));
+    nn.add_layer(make_unique<Dense<float>>(4 * 3 * 3, 1, init, init));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+    nn.train<BCELoss, Adam>(images, labels, 60, 16, 0.01f);
+    const auto predictions = nn.predict(images);
+    size_t correct = 0;
+    for (size_t i = 0; i < 64; ++i) correct += (predictions(i, 0) > 0.5f) == (labels(i, 0) > 0.5f);
+    if (correct < 60) {
+        cerr << "FALLO: la CNN acierta solo " << correct << " de 64" << endl;
+        return 1;
+    }
+
+    const string path = "test_conv2d.nn";
+    nn.save(path);
+    NeuralNetwork<float> loaded;
+    loaded.load(path);
+    remove(path.c_str());
+    const auto reloaded = loaded.predict(images);
+    for (size_t i = 0; i < 64; ++i)
+        if (fabs(reloaded(i, 0) - predictions(i, 0)) > 1e-4f) {
+            cerr << "FALLO: la CNN cargada predice distinto" << endl;
+            return 1;
+        }
+
+    cout << "Conv2D y pooling OK (" << correct << "/64)" << endl;
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+#include <numeric>
+#include <vector>
+#include "utec/algebra/simd.h"
+#include "utec/neural_network/data/mnist_loader.h"
+
+using namespace std;
+
+namespace {
+
+// Pixel j de la fila r; con 40 filas aparecen los 256 valores.
+int pixel(size_t r, size_t j) {
+    return static_cast<int>((r * 37 + j * 11) % 256);
+}
+
+// Compara el batch contra la conversión anterior a uint8: floats de la
+// fila divididos entre 255 y, si hay estandarización, (x - mean) / std.
+bool matches_float_path(const MNISTLoader& loader, size_t rows, float mean, float stddev, float tolerance) {
+    vector<size_t> indices(rows);
+    iota(indices.begin(), indices.end(), size_t(0));
+    vector<float> x(rows * 784), y(rows * 10);
+    loader.gatherBatch(indices.data(), rows, x.data(), y.data());
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t j = 0; j < 784; ++j) {
+            const float expected = (static_cast<float>(pixel(r, j)) / 255.0f - mean) / stddev;
+            if (fabs(x[r * 784 + j] - expected) > tolerance) {
+                cerr << "FALLO: fila " << r << ", pixel " << j << ": " << x[r * 784 + j] << " contra " << expected << endl;
+                return false;
+            }
+        }
+        for (size_t c = 0; c < 10; ++c)
+            if (y[r * 10 + c] != (c == r % 10 ? 1.0f : 0.0f)) {
+                cerr << "FALLO: one-hot de la fila " << r << endl;
+                return false;
+            }
+    }
+    return true;
+}
+
+} // namespace
+
+// Pixeles guardados como uint8 y convertidos en gatherBatch: mismos valores
+// que los floats /255 de antes, con y sin estandarización; y en
+// simd::dequantize_u8 la ruta vectorial y la cola escalar coinciden para
+// cualquier ancho.
+int main() {
+    const string path = "test_dequantize.csv";
+    const size_t rows = 40;
+    {
+        ofstream out(path);
+        out << "label";
+        for (size_t j = 0; j < 784; ++j) out << ",p" << j;
+        out << "\n";
+        for (size_t r = 0; r < rows; ++r) {
+            out << r % 10;
+            for (size_t j = 0; j < 784; ++j) out << "," << pixel(r, j);
+            out << "\n";
+        }
+    }
+    MNISTLoader loader;
+    streambuf* saved = cout.rdbuf(nullptr);
+    const bool loaded = loader.loadTrainData(path);
+    cout.rdbuf(saved);
+    remove(path.c_str());
+    if (!loaded || static_cast<size_t>(loader.getTrainSize()) != rows) {
+        cerr << "FALLO: no se cargó el CSV" << endl;
+        return 1;
+    }
+    if (!matches_float_path(loader, rows, 0.0f, 1.0f, 1.2e-7f)) return 1;
+    loader.setStandardization(0.1307f, 0.3081f);
+    if (!matches_float_path(loader, rows, 0.1307f, 0.3081f, 1e-6f)) return 1;
+
+    // Cada elemento contra la misma conversión hecha de a uno (solo la cola
+    // escalar), para anchos impares y desde direcciones desalineadas.
+    vector<uint8_t> src(300);
+    for (size_t i = 0; i < src.size(); ++i) src[i] = static_cast<uint8_t>(i * 97 + 13);
+    const float a = 1.0f / 255.0f / 0.3081f, b = -0.1307f / 0.3081f;
+    for (size_t offset : {size_t(0), size_t(1), size_t(3)}) {
+        for (size_t n = 1; n < 80; n += 2) {
+            vector<float> simd(n), scalar(n);
+            utec::algebra::simd::dequantize_u8(src.data() + offset, simd.data(), n, a, b);
+            for (size_t i = 0; i < n; ++i)
+                utec::algebra::simd::dequantize_u8(src.data() + offset + i, &scalar[i], 1, a, b);
+            if (simd != scalar) {
+                cerr << "FALLO: dequantize_u8 con ancho " << n << " y desplazamiento " << offset
+                     << " no coincide con la ruta escalar" << endl;
+                return 1;
+            }
+        }
+    }
+
+    cout << "Dequantize OK" << endl;
+    return 0;
+}
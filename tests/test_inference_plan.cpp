@@ -0,0 +1,55 @@
+#include <iostream>
+#include <random>
+#include <cmath>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// predict con plan de inferencia (y predict_one) debe coincidir con el camino
+// capa por capa, también con batches que no son múltiplo del bloque de filas
+// del kernel.
+int main(int argc, char* argv[]) {
+    const string path = argc > 1 ? argv[1] : "modelo.nn";
+    NeuralNetwork<float> reference, planned;
+    reference.load(path);
+    planned.load(path, true);
+    if (!planned.has_plan()) {
+        cerr << "FALLO: load no armó el plan" << endl;
+        return 1;
+    }
+
+    mt19937 gen(8);
+    uniform_real_distribution<float> dist(0.0f, 1.0f);
+    float max_diff = 0.0f;
+    for (size_t n : {1, 3, 4, 7, 64}) {
+        Tensor<float, 2> X(n, 784);
+        for (auto& v : X) v = dist(gen);
+        auto expected = reference.predict(X);
+        auto got = planned.predict(X);
+        for (size_t i = 0; i < got.data.size(); ++i)
+            max_diff = max(max_diff, fabs(got.data[i] - expected.data[i]));
+    }
+
+    // predict_one: una fila a la vez contra predict del batch completo.
+    Tensor<float, 2> X(9, 784);
+    for (auto& v : X) v = dist(gen);
+    auto expected = reference.predict(X);
+    vector<float> y(expected.shape()[1]);
+    for (size_t r = 0; r < X.shape()[0]; ++r) {
+        planned.predict_one(&X(r, 0), y.data());
+        for (size_t j = 0; j < y.size(); ++j)
+            max_diff = max(max_diff, fabs(y[j] - expected(r, j)));
+    }
+    cout << "Diferencia maxima: " << max_diff << endl;
+
+    // Con -march=native el compilador puede fusionar en FMA el camino capa
+    // por capa y no el kernel, así que se admite una diferencia pequeña.
+    if (max_diff > 1e-4f) {
+        cerr << "FALLO: el plan no coincide con predict" << endl;
+        return 1;
+    }
+    cout << "OK" << endl;
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <cmath>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+bool near(double a, double b, double tol = 1e-5) { return fabs(a - b) <= tol; }
+
+template<template <typename...> class Opt>
+bool converges(const Tensor<float, 2>& X, const Tensor<float, 2>& Y, float lr) {
+    mt19937 gen(3);
+    uniform_real_distribution<float> dist(-0.5f, 0.5f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Dense<float>>(4, 16, init, init));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<Dense<float>>(16, 1, init, init));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+    nn.set_lr_schedule(make_shared<Warmup<float>>(5, make_shared<Cosine<float>>(95)));
+    nn.train<BCELoss, Opt>(X, Y, 25, 64, lr);
+    const auto& h = nn.history();
+    return h.back().train_loss < 0.7f * h.front().train_loss && h.back().learning_rate < lr * 0.05f;
+}
+
+// El estado guardado debe reproducir exactamente las actualizaciones.
+template<typename Opt>
+bool state_roundtrip() {
+    Tensor<float, 2> w(3, 4), g(3, 4), b(1, 4), gb(1, 4);
+    for (size_t i = 0; i < w.size(); ++i) {
+        w.begin()[i] = 0.1f * float(i) - 0.3f;
+        g.begin()[i] = 0.05f * float(i % 5) - 0.1f;
+    }
+    for (size_t i = 0; i < 4; ++i) { b.begin()[i] = 0.1f; gb.begin()[i] = 0.2f - 0.1f * float(i); }
+    Opt a;
+    for (int s = 0; s < 3; ++s) { a.update(w, g); a.update(b, gb, ParamKind::Bias); a.step(); }
+    stringstream state;
+    a.save_state(state);
+    Opt c;
+    c.load_state(state);
+    auto w1 = w, w2 = w, b1 = b, b2 = b;
+    a.update(w1, g); a.update(b1, gb, ParamKind::Bias); a.step();
+    c.update(w2, g); c.update(b2, gb, ParamKind::Bias); c.step();
+    return w1.data == w2.data && b1.data == b2.data;
+}
+
+// Qué es sesgo lo dice la capa, no la forma: un tensor de pesos de una fila
+// (los valores de SparseDense) también lleva tasa local y weight decay.
+template<typename Opt>
+bool bias_from_layer() {
+    Tensor<float, 2> w(1, 6), g(1, 6);
+    for (size_t i = 0; i < w.size(); ++i) {
+        w.begin()[i] = 0.2f * float(i) - 0.5f;
+        g.begin()[i] = 0.03f * float(i % 4) - 0.05f;
+    }
+    auto as_weight = w, as_bias = w;
+    Opt a, c;
+    a.update(as_weight, g, ParamKind::Weight);
+    c.update(as_bias, g, ParamKind::Bias);
+    return as_weight.data != as_bias.data;
+}
+
+} // namespace
+
+// Valores de los programas de tasa, LARS/LAMB convergiendo con warmup +
+// coseno, estado de los optimizadores para checkpoints y sesgos marcados por
+// la capa.
+int main() {
+    bool ok = true;
+    ok &= near(StepDecay<float>(10, 0.5f).rate(25, 1.0f), 0.25);
+    ok &= near(Cosine<float>(100).rate(0, 2.0f), 2.0) && near(Cosine<float>(100).rate(50, 2.0f), 1.0)
+       && near(Cosine<float>(100, 0.1f).rate(100, 1.0f), 0.1) && near(Cosine<float>(100).rate(500, 1.0f), 0.0);
+    Warmup<float> warm(4, make_shared<StepDecay<float>>(2, 0.5f));
+    ok &= near(warm.rate(0, 1.0f), 0.25) && near(warm.rate(3, 1.0f), 1.0) && near(warm.rate(6, 1.0f), 0.5);
+    OneCycle<float> cycle(100, 0.3, 25.0, 1e4);
+    ok &= near(cycle.rate(0, 1.0f), 0.04) && near(cycle.rate(30, 1.0f), 1.0) && near(cycle.rate(99, 1.0f), 1e-4);
+    if (!ok) {
+        cerr << "FALLO: valores de los programas de tasa" << endl;
+        return 1;
+    }
+
+    mt19937 gen(8);
+    normal_distribution<float> noise(0.0f, 1.0f);
+    Tensor<float, 2> X(256, 4), Y(256, 1);
+    for (size_t i = 0; i < 256; ++i) {
+        for (size_t j = 0; j < 4; ++j) X(i, j) = noise(gen);
+        Y(i, 0) = X(i, 0) * X(i, 1) > 0.0f ? 1.0f : 0.0f;
+    }
+    if (!converges<LAMB>(X, Y, 0.05f) || !converges<LARS>(X, Y, 5.0f) || !converges<SGD>(X, Y, 0.5f)) {
+        cerr << "FALLO: no converge con warmup + coseno" << endl;
+        return 1;
+    }
+    if (!state_roundtrip<LAMB<float>>() || !state_roundtrip<LARS<float>>()) {
+        cerr << "FALLO: estado del optimizador" << endl;
+        return 1;
+    }
+    if (!bias_from_layer<LAMB<float>>() || !bias_from_layer<LARS<float>>()) {
+        cerr << "FALLO: un tensor de pesos de una fila se trató como sesgo" << endl;
+        return 1;
+    }
+    cout << "OK" << endl;
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <iostream>
+#include <random>
+#include "utec/neural_network/nn_metrics.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+// Devuelve las filas tal cual: permite evaluar puntajes fijos.
+struct Identity {
+    Tensor<float, 2> predict(const Tensor<float, 2>& x) { return x; }
+};
+
+size_t scalar_argmax(const float* x, size_t n) {
+    size_t best = 0;
+    for (size_t j = 1; j < n; ++j)
+        if (x[j] > x[best]) best = j;
+    return best;
+}
+
+} // namespace
+
+// argmax SIMD contra el escalar (con empates) y evaluación paralela contra
+// una pasada en un solo hilo.
+int main() {
+    mt19937 gen(12);
+    uniform_int_distribution<int> coarse(0, 6);
+    for (size_t n : {1, 7, 8, 10, 17, 33}) {
+        vector<float> row(n);
+        for (int trial = 0; trial < 200; ++trial) {
+            for (auto& v : row) v = static_cast<float>(coarse(gen));
+            if (simd::argmax(row.data(), n) != scalar_argmax(row.data(), n)) {
+                cerr << "FALLO: argmax distinto con n = " << n << endl;
+                return 1;
+            }
+        }
+    }
+
+    const size_t rows = 1000, classes = 10;
+    Tensor<float, 2> scores(rows, classes);
+    vector<int> labels(rows);
+    uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (auto& v : scores) v = dist(gen);
+    for (auto& l : labels) l = static_cast<int>(gen() % classes);
+
+    Identity model;
+    auto serial = evaluate(model, scores, labels, classes, {rows, 1, 3});
+    auto parallel = evaluate(model, scores, labels, classes, {37, 3, 3});
+
+    bool same = serial.correct() == parallel.correct() && serial.top_k_accuracy() == parallel.top_k_accuracy();
+    uint64_t sum = 0;
+    for (size_t a = 0; a < classes; ++a)
+        for (size_t p = 0; p < classes; ++p) {
+            same = same && serial.confusion(a, p) == parallel.confusion(a, p);
+            sum += parallel.confusion(a, p);
+        }
+    cout << "Exactitud: " << parallel.accuracy() << ", top-3: " << parallel.top_k_accuracy() << endl;
+
+    if (!same || sum != rows || parallel.top_k_accuracy() < parallel.accuracy()) {
+        cerr << "FALLO: la evaluación paralela no coincide" << endl;
+        return 1;
+    }
+    cout << "OK" << endl;
+    return 0;
+}
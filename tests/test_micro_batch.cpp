@@ -0,0 +1,85 @@
+#include <iostream>
+#include <random>
+#include <cmath>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+NeuralNetwork<float> make_network(size_t in, size_t hidden, uint32_t seed) {
+    mt19937 gen(seed);
+    uniform_real_distribution<float> dist(-0.3f, 0.3f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Dense<float>>(in, hidden, init, init));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<Dense<float>>(hidden, 2, init, init));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+    return nn;
+}
+
+// Pico de bytes vivos de Tensor durante un train.
+template<typename Train>
+int64_t peak_during(Train train) {
+    telemetry::reset();
+    const int64_t before = telemetry::totals().live_bytes;
+    train();
+    return telemetry::totals().peak_bytes - before;
+}
+
+} // namespace
+
+// Compilado con UTEC_TENSOR_TELEMETRY: con micro-batches los pesos quedan
+// igual que con el batch completo (mismos pasos del optimizador) y el pico
+// de memoria baja.
+int main() {
+    mt19937 gen(47);
+    normal_distribution<float> noise(0.0f, 1.0f);
+    Tensor<float, 2> X(200, 6), Y(200, 2);
+    for (size_t i = 0; i < 200; ++i) {
+        for (size_t j = 0; j < 6; ++j) X(i, j) = noise(gen);
+        Y(i, X(i, 0) * X(i, 1) > 0.0f ? 1 : 0) = 1.0f;
+    }
+
+    auto full = make_network(6, 16, 1);
+    auto micro = make_network(6, 16, 1);
+    full.train<BCELoss, Adam>(X, Y, 3, 40, 0.01f);
+    micro.train<BCELoss, Adam>(X, Y, 3, 40, 0.01f, 7);
+    if (full.training_state().step != micro.training_state().step) {
+        cerr << "FALLO: los micro-batches cambiaron el número de pasos" << endl;
+        return 1;
+    }
+    for (size_t l = 0; l < full.dlayers().size(); ++l) {
+        auto a = full.dlayers()[l]->parameters(), b = micro.dlayers()[l]->parameters();
+        for (size_t p = 0; p < a.size(); ++p)
+            for (size_t i = 0; i < a[p]->size(); ++i)
+                if (fabs(a[p]->data[i] - b[p]->data[i]) > 1e-4f) {
+                    cerr << "FALLO: pesos distintos en la capa " << l << endl;
+                    return 1;
+                }
+    }
+    const float full_loss = full.history().back().train_loss, micro_loss = micro.history().back().train_loss;
+    if (fabs(full_loss - micro_loss) > 1e-4f) {
+        cerr << "FALLO: pérdida por época distinta: " << full_loss << " vs " << micro_loss << endl;
+        return 1;
+    }
+
+    // Capa ancha: las activaciones dominan la memoria.
+    Tensor<float, 2> Xw(512, 32), Yw(512, 2);
+    for (auto& v : Xw) v = noise(gen);
+    for (size_t i = 0; i < 512; ++i) Yw(i, i % 2) = 1.0f;
+    auto wide_full = make_network(32, 1024, 2);
+    auto wide_micro = make_network(32, 1024, 2);
+    const int64_t peak_full = peak_during([&] { wide_full.train<MSELoss, SGD>(Xw, Yw, 1, 512, 0.01f); });
+    const int64_t peak_micro = peak_during([&] { wide_micro.train<MSELoss, SGD>(Xw, Yw, 1, 512, 0.01f, 64); });
+    cout << "Pico con batch 512: " << peak_full / 1024 << " KB, con micro-batch 64: " << peak_micro / 1024 << " KB\n";
+    if (!(peak_micro * 3 < peak_full)) {
+        cerr << "FALLO: el micro-batch no bajó el pico de memoria" << endl;
+        return 1;
+    }
+    cout << "OK" << endl;
+    return 0;
+}
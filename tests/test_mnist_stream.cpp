@@ -0,0 +1,147 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
+#include "utec/neural_network/data/mnist_stream.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+// Fila r: etiqueta r % 10 y su número en los dos primeros pixeles.
+void write_csv(const string& path, size_t rows) {
+    ofstream out(path);
+    out << "label";
+    for (size_t j = 0; j < 784; ++j) out << ",p" << j;
+    out << "\n";
+    for (size_t r = 0; r < rows; ++r) {
+        out << r % 10 << "," << r % 256 << "," << r / 256;
+        for (size_t j = 2; j < 784; ++j) out << "," << (j * 7 + r) % 256;
+        out << "\n";
+    }
+}
+
+size_t row_of(const float* x) {
+    return static_cast<size_t>(lround(x[0] * 255.0f)) + 256 * static_cast<size_t>(lround(x[1] * 255.0f));
+}
+
+// Recorre una época y comprueba que cada fila sale una vez, con su
+// etiqueta, y que solo el último batch es parcial.
+bool epoch_ok(MNISTStream<float>& stream, size_t rows, size_t batch_size, bool& shuffled) {
+    vector<int> seen(rows, 0);
+    size_t emitted = 0, position = 0;
+    shuffled = false;
+    while (auto batch = stream.next()) {
+        if (emitted + batch->size < rows && batch->size != batch_size) {
+            cerr << "FALLO: batch parcial antes del final" << endl;
+            return false;
+        }
+        for (size_t i = 0; i < batch->size; ++i) {
+            const size_t r = row_of(batch->x.data.data() + i * 784);
+            if (r >= rows || batch->y(i, r % 10) != 1.0f) {
+                cerr << "FALLO: fila " << r << " con etiqueta equivocada" << endl;
+                return false;
+            }
+            ++seen[r];
+            shuffled |= r != position++;
+        }
+        emitted += batch->size;
+    }
+    for (size_t r = 0; r < rows; ++r)
+        if (seen[r] != 1) {
+            cerr << "FALLO: la fila " << r << " salió " << seen[r] << " veces" << endl;
+            return false;
+        }
+    return true;
+}
+
+} // namespace
+
+// MNISTStream: cada fila una vez por época, último batch parcial, límite de
+// filas y memoria acotada que no depende del tamaño del archivo. count_rows y
+// read_rows dan la división entrenamiento / validación de --stream sin
+// cargar el CSV.
+int main() {
+    const string small_path = "test_stream_small.csv", large_path = "test_stream_large.csv";
+    const size_t small_rows = 203, large_rows = 1203, batch = 32;
+    write_csv(small_path, small_rows);
+    write_csv(large_path, large_rows);
+
+    size_t ceilings[2];
+    const string paths[2] = {small_path, large_path};
+    const size_t rows[2] = {small_rows, large_rows};
+    for (int f = 0; f < 2; ++f) {
+        MNISTStream<float> stream(paths[f], batch, 64, 4096, 7);
+        bool shuffled = false;
+        for (int epoch = 0; epoch < 2; ++epoch)
+            if (!epoch_ok(stream, rows[f], batch, shuffled)) return 1;
+        if (!shuffled) {
+            cerr << "FALLO: el buffer de mezcla no cambia el orden" << endl;
+            return 1;
+        }
+        const auto& stats = stream.stats();
+        if (stats.samples != 2 * rows[f] || stats.bytes_read != 2 * filesystem::file_size(paths[f]) ||
+            stats.mb_per_s() <= 0.0 || stats.samples_per_s() <= 0.0) {
+            cerr << "FALLO: estadísticas inesperadas" << endl;
+            return 1;
+        }
+        ceilings[f] = stream.memory_ceiling();
+    }
+    // Bloque, buffer de mezcla y un batch: igual para 200 que para 1200 filas.
+    const size_t bound = 2 * 4096 + 64 * 784 + 64 * sizeof(int) + batch * (784 + 10) * sizeof(float);
+    if (ceilings[0] != ceilings[1] || ceilings[1] > bound) {
+        cerr << "FALLO: memoria " << ceilings[0] << " / " << ceilings[1] << " bytes (cota " << bound << ")" << endl;
+        return 1;
+    }
+
+    MNISTStream<float> limited(large_path, batch, 64, 4096, 7);
+    limited.limit_rows(100);
+    bool shuffled = false;
+    if (!epoch_ok(limited, 100, batch, shuffled) || !epoch_ok(limited, 100, batch, shuffled)) return 1;
+
+    // Validación como en --stream: las últimas 103 filas, en orden, y el
+    // stream de entrenamiento se queda con el resto.
+    const size_t total = MNISTStream<float>::count_rows(large_path), tail = 103;
+    if (total != large_rows) {
+        cerr << "FALLO: count_rows dio " << total << " filas" << endl;
+        return 1;
+    }
+    Tensor<float, 2> X_val(tail, 784), Y_val(tail, 10);
+    MNISTStream<float>::read_rows(large_path, total - tail, X_val, Y_val);
+    for (size_t i = 0; i < tail; ++i) {
+        const size_t r = row_of(X_val.data.data() + i * 784);
+        if (r != total - tail + i || Y_val(i, r % 10) != 1.0f) {
+            cerr << "FALLO: la fila " << i << " de validación es la " << r << endl;
+            return 1;
+        }
+    }
+    MNISTStream<float> tail_stream(large_path, batch, 64, 4096, 7);
+    tail_stream.skip_rows(total - tail);
+    vector<int> seen(large_rows, 0);
+    while (auto b = tail_stream.next())
+        for (size_t i = 0; i < b->size; ++i) ++seen[row_of(b->x.data.data() + i * 784)];
+    for (size_t r = 0; r < large_rows; ++r)
+        if (seen[r] != (r >= total - tail ? 1 : 0)) {
+            cerr << "FALLO: skip_rows entregó la fila " << r << " " << seen[r] << " veces" << endl;
+            return 1;
+        }
+    bool thrown = false;
+    try {
+        MNISTStream<float>::read_rows(large_path, total - 10, X_val, Y_val);
+    } catch (const runtime_error&) {
+        thrown = true;
+    }
+    if (!thrown) {
+        cerr << "FALLO: read_rows aceptó más filas de las que hay" << endl;
+        return 1;
+    }
+
+    remove(small_path.c_str());
+    remove(large_path.c_str());
+    cout << "MNISTStream OK (" << ceilings[1] / 1024 << " KB)" << endl;
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+string read_file(const string& path) {
+    ifstream in(path, ios::binary);
+    return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+void write_file(const string& path, const string& bytes) {
+    ofstream out(path, ios::binary);
+    out.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+}
+
+// Escribe `bytes` en un archivo nuevo (cada caso con su nombre, para no
+// reusar un mapeo ya validado) y devuelve true si read lo rechaza.
+bool rejected(const string& name, const string& bytes) {
+    const string path = "test_model_file_" + name + ".nnb";
+    write_file(path, bytes);
+    bool thrown = false;
+    try {
+        model_file::read<float>(path);
+    } catch (const runtime_error&) {
+        thrown = true;
+    }
+    remove(path.c_str());
+    return thrown;
+}
+
+bool same_dense(const ILayer<float>* a, const ILayer<float>* b) {
+    auto da = dynamic_cast<const Dense<float>*>(a);
+    auto db = dynamic_cast<const Dense<float>*>(b);
+    if (!da || !db) return !da && !db && typeid(*a) == typeid(*b);
+    return da->in_features() == db->in_features() && da->out_features() == db->out_features()
+        && memcmp(da->weights_data(), db->weights_data(), da->in_features() * da->out_features() * sizeof(float)) == 0
+        && memcmp(da->biases_data(), db->biases_data(), da->out_features() * sizeof(float)) == 0;
+}
+
+} // namespace
+
+// Formato binario: ida y vuelta exacta (mapeado y copiado) y rechazo de un
+// byte cambiado, de versión o magic inválidos, de un archivo truncado y de
+// dimensiones que desbordarían rows * cols.
+int main() {
+    mt19937 gen(30);
+    uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Dense<float>>(12, 9, init, init));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<Dense<float>>(9, 3, init, init));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+
+    const string path = "test_model_file.nnb";
+    nn.save_binary(path);
+    Tensor<float, 2> x(5, 12);
+    init(x);
+    const auto expected = nn.predict(x);
+    for (bool in_place : {true, false}) {
+        NeuralNetwork<float> loaded;
+        loaded.load_binary(path, in_place);
+        if (loaded.dlayers().size() != nn.dlayers().size()) {
+            cerr << "FALLO: se leyeron " << loaded.dlayers().size() << " capas" << endl;
+            return 1;
+        }
+        for (size_t i = 0; i < nn.dlayers().size(); ++i)
+            if (!same_dense(nn.dlayers()[i].get(), loaded.dlayers()[i].get())) {
+                cerr << "FALLO: la capa " << i << " cambió en la ida y vuelta" << endl;
+                return 1;
+            }
+        if (loaded.predict(x).data != expected.data) {
+            cerr << "FALLO: la predicción cambió (in_place " << in_place << ")" << endl;
+            return 1;
+        }
+    }
+
+    const string bytes = read_file(path);
+    remove(path.c_str());
+    model_file::Header header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    model_file::LayerEntry first;
+    memcpy(&first, bytes.data() + header.table_offset, sizeof(first));
+
+    string weight = bytes, table = bytes, version = bytes, magic = bytes, dtype = bytes;
+    weight[first.weights_offset + 5] ^= 0x01;
+    table[header.table_offset + offsetof(model_file::LayerEntry, cols)] ^= 0x01;
+    version[offsetof(model_file::Header, version)] = 9;
+    magic[0] = 'X';
+    dtype[offsetof(model_file::Header, dtype)] = static_cast<char>(model_file::DType::Float64);
+
+    // rows * cols * 4 da la vuelta a 64 bits y quedaría dentro del archivo;
+    // con el CRC de la tabla recalculado solo la cota lo detecta.
+    string overflow = bytes;
+    model_file::LayerEntry huge = first;
+    huge.rows = (uint64_t(1) << 62) + 1;
+    huge.cols = 4;
+    memcpy(&overflow[header.table_offset], &huge, sizeof(huge));
+    model_file::Header fixed = header;
+    fixed.table_checksum = model_file::crc32(overflow.data() + header.table_offset,
+                                             sizeof(model_file::LayerEntry) * header.layer_count);
+    memcpy(&overflow[0], &fixed, sizeof(fixed));
+
+    const pair<const char*, const string*> cases[] = {
+        {"peso", &weight}, {"tabla", &table}, {"version", &version}, {"magic", &magic}, {"dtype", &dtype},
+        {"desborde", &overflow},
+    };
+    for (const auto& [name, data] : cases)
+        if (!rejected(name, *data)) {
+            cerr << "FALLO: se aceptó el archivo con " << name << " inválido" << endl;
+            return 1;
+        }
+    const string truncated = bytes.substr(0, bytes.size() - 100);
+    if (!rejected("truncado", truncated) || !rejected("cabecera", bytes.substr(0, 20))) {
+        cerr << "FALLO: se aceptó un archivo truncado" << endl;
+        return 1;
+    }
+
+    cout << "Model file OK (" << bytes.size() << " bytes)" << endl;
+    return 0;
+}
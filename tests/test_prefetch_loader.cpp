@@ -0,0 +1,140 @@
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "utec/neural_network/data/prefetch_loader.h"
+
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+const size_t samples = 50, batch_size = 8;
+
+// Fila i: x = (i, -i), y = 2i.
+void gather(const size_t* indices, size_t n, float* x, float* y) {
+    for (size_t r = 0; r < n; ++r) {
+        x[r * 2] = float(indices[r]);
+        x[r * 2 + 1] = -float(indices[r]);
+        y[r] = 2.0f * float(indices[r]);
+    }
+}
+
+// Índices de una época tal como salen del loader, o vacío si algo no cuadra.
+vector<size_t> epoch(PrefetchLoader<float>& loader) {
+    vector<size_t> order;
+    size_t batches = 0;
+    while (auto batch = loader.next()) {
+        const size_t expected = min(batch_size, samples - batches * batch_size);
+        if (batch->size != expected || batch->x.shape()[0] != expected || batch->y.shape()[0] != expected) {
+            cerr << "FALLO: batch " << batches << " de " << batch->size << " filas, se esperaban " << expected << endl;
+            return {};
+        }
+        for (size_t r = 0; r < batch->size; ++r) {
+            const float i = batch->x(r, 0);
+            if (batch->x(r, 1) != -i || batch->y(r, 0) != 2.0f * i) {
+                cerr << "FALLO: la fila " << i << " no coincide con su etiqueta" << endl;
+                return {};
+            }
+            order.push_back(size_t(i));
+        }
+        ++batches;
+    }
+    return order;
+}
+
+bool is_permutation_of_all(vector<size_t> order) {
+    sort(order.begin(), order.end());
+    for (size_t i = 0; i < order.size(); ++i)
+        if (order[i] != i) return false;
+    return order.size() == samples;
+}
+
+} // namespace
+
+// PrefetchLoader: orden con y sin mezcla, último batch parcial, cierre del
+// hilo a mitad de época y reanudación desde save_position() con los mismos
+// batches restantes.
+int main() {
+    vector<size_t> identity(samples);
+    iota(identity.begin(), identity.end(), size_t(0));
+    {
+        PrefetchLoader<float> loader(samples, 2, 1, batch_size, gather, 2, false);
+        if (epoch(loader) != identity || epoch(loader) != identity) {
+            cerr << "FALLO: sin mezcla el orden no es 0..n-1 en cada época" << endl;
+            return 1;
+        }
+        if (loader.stats().batches != 2 * loader.batches_per_epoch()) {
+            cerr << "FALLO: " << loader.stats().batches << " batches entregados" << endl;
+            return 1;
+        }
+    }
+
+    vector<size_t> first, second;
+    {
+        PrefetchLoader<float> loader(samples, 2, 1, batch_size, gather, 3, true, 5);
+        first = epoch(loader);
+        second = epoch(loader);
+        if (!is_permutation_of_all(first) || !is_permutation_of_all(second)) {
+            cerr << "FALLO: con mezcla una época no recorre cada fila una vez" << endl;
+            return 1;
+        }
+        if (first == identity || first == second) {
+            cerr << "FALLO: la mezcla no cambia el orden entre épocas" << endl;
+            return 1;
+        }
+    }
+    {
+        PrefetchLoader<float> same_seed(samples, 2, 1, batch_size, gather, 2, true, 5);
+        if (epoch(same_seed) != first || epoch(same_seed) != second) {
+            cerr << "FALLO: la misma semilla da otro orden" << endl;
+            return 1;
+        }
+    }
+
+    // Se destruye con el productor esperando un buffer libre, a mitad de
+    // época y sin haber pedido nada: no debe colgarse.
+    for (size_t consumed : {size_t(0), size_t(1), size_t(3)}) {
+        PrefetchLoader<float> loader(samples, 2, 1, batch_size, gather, 2, true, 5);
+        for (size_t b = 0; b < consumed; ++b) loader.next();
+    }
+
+    // Reanudación a mitad de época y justo después del fin de época: los
+    // batches que quedan son los mismos que sin interrumpir.
+    const size_t per_epoch = (samples + batch_size - 1) / batch_size;
+    for (size_t stop : {size_t(3), per_epoch + 1}) {
+        string position;
+        vector<size_t> remaining;
+        {
+            PrefetchLoader<float> loader(samples, 2, 1, batch_size, gather, 2, true, 5);
+            for (size_t b = 0; b < stop; ++b) loader.next();
+            position = loader.save_position();
+            for (size_t b = 0; b < 2 * per_epoch; ++b)
+                if (auto batch = loader.next()) remaining.push_back(size_t(batch->x(0, 0)));
+                else remaining.push_back(samples);
+        }
+        PrefetchLoader<float> resumed(samples, 2, 1, batch_size, gather, 2, true, 5, position);
+        vector<size_t> replay;
+        for (size_t b = 0; b < 2 * per_epoch; ++b)
+            if (auto batch = resumed.next()) replay.push_back(size_t(batch->x(0, 0)));
+            else replay.push_back(samples);
+        if (position.empty() || replay != remaining) {
+            cerr << "FALLO: reanudar tras " << stop << " llamadas no repite los batches restantes" << endl;
+            return 1;
+        }
+    }
+
+    bool thrown = false;
+    try {
+        PrefetchLoader<float> broken(samples, 2, 1, batch_size, gather, 2, true, 5, "no es una posicion");
+    } catch (const runtime_error&) {
+        thrown = true;
+    }
+    if (!thrown) {
+        cerr << "FALLO: se aceptó una posición inválida" << endl;
+        return 1;
+    }
+
+    cout << "PrefetchLoader OK" << endl;
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <string>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Compilado con UTEC_NN_PROFILE: train y predict deben dejar un evento por
+// capa y fase, con FLOPs y reservas, y una traza JSON legible. Con el tope de
+// eventos la traza no crece, pero el resumen sigue contando todo.
+int main() {
+    mt19937 gen(5);
+    uniform_real_distribution<float> dist(-0.1f, 0.1f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Dense<float>>(16, 8, init, init));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<Dense<float>>(8, 4, init, init));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+
+    Tensor<float, 2> X(40, 16), Y(40, 4);
+    init(X);
+    for (size_t i = 0; i < 40; ++i) Y(i, i % 4) = 1.0f;
+
+    auto& prof = profiler::Profiler::instance();
+    prof.clear();
+    nn.train<MSELoss>(X, Y, 2, 10, 0.1f);
+    nn.predict(X);
+
+    size_t steps = 0, dense_forward = 0, backward = 0, copies = 0, predicts = 0;
+    uint64_t allocations = 0;
+    for (const auto& e : prof.events()) {
+        steps += e.phase == profiler::Phase::Step;
+        copies += e.phase == profiler::Phase::BatchCopy;
+        backward += e.phase == profiler::Phase::Backward;
+        predicts += e.phase == profiler::Phase::Predict;
+        if (e.phase == profiler::Phase::Forward && e.name == "0:Dense 16x8") {
+            ++dense_forward;
+            if (e.flops != 2ull * 10 * 16 * 8) {
+                cerr << "FALLO: FLOPs inesperados " << e.flops << endl;
+                return 1;
+            }
+        }
+        allocations += e.allocations;
+    }
+    if (steps != 8 || copies != 8 || dense_forward != 8 || backward != 32 || predicts != 4 || allocations == 0) {
+        cerr << "FALLO: eventos inesperados (" << steps << ", " << copies << ", " << dense_forward << ", "
+             << backward << ", " << predicts << ", " << allocations << ")" << endl;
+        return 1;
+    }
+
+    ostringstream table;
+    prof.summary(table);
+    const string trace = "test_profiler_trace.json";
+    prof.write_chrome_trace(trace);
+    ifstream in(trace);
+    const string json((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    remove(trace.c_str());
+    if (table.str().find("0:Dense 16x8") == string::npos
+        || json.find("\"traceEvents\"") == string::npos || json.find("\"cat\":\"backward\"") == string::npos) {
+        cerr << "FALLO: resumen o traza incompletos" << endl;
+        return 1;
+    }
+
+    const size_t recorded = prof.events().size();
+    prof.clear();
+    prof.set_max_events(5);
+    nn.train<MSELoss>(X, Y, 2, 10, 0.1f);
+    const auto totals = prof.totals();
+    const auto dense = totals.find({static_cast<int>(profiler::Phase::Forward), "0:Dense 16x8"});
+    if (prof.events().size() != 5 || prof.dropped() == 0 || dense == totals.end() || dense->second.calls != 8
+        || dense->second.flops != 8 * 2ull * 10 * 16 * 8) {
+        cerr << "FALLO: con el tope quedaron " << prof.events().size() << " eventos" << endl;
+        return 1;
+    }
+    uint64_t calls = 0;
+    for (const auto& [key, row] : totals) calls += row.calls;
+    if (calls != 5 + prof.dropped()) {
+        cerr << "FALLO: el resumen no cuenta los eventos descartados" << endl;
+        return 1;
+    }
+
+    cout << table.str();
+    cout << "OK: " << recorded << " eventos" << endl;
+    return 0;
+}
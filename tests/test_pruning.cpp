@@ -0,0 +1,71 @@
+#include <iostream>
+#include <random>
+#include <cmath>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Poda gradual durante train: tras cada actualización de la máscara la
+// dispersión es exactamente la del programa para ese paso, y entre
+// actualizaciones los pesos podados siguen en cero aunque Adam los empuje.
+int main() {
+    mt19937 gen(34);
+    uniform_real_distribution<float> dist(-0.5f, 0.5f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Dense<float>>(16, 32, init, init));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<Dense<float>>(32, 1, init, init));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+
+    normal_distribution<float> noise(0.0f, 1.0f);
+    Tensor<float, 2> X(64, 16), Y(64, 1);
+    for (size_t i = 0; i < 64; ++i) {
+        for (size_t j = 0; j < 16; ++j) X(i, j) = noise(gen);
+        Y(i, 0) = X(i, 0) + X(i, 3) > 0.0f ? 1.0f : 0.0f;
+    }
+
+    // 4 pasos por época; la máscara cambia en los pasos 8, 16 y 24 (y en el
+    // primero, cuando todavía no hay máscaras).
+    PruningSchedule schedule;
+    schedule.final_sparsity = 0.75;
+    schedule.begin_step = 0;
+    schedule.end_step = 24;
+    schedule.frequency = 8;
+    nn.enable_pruning(schedule);
+
+    vector<vector<bool>> previous(2);
+    bool ok = true;
+    nn.on_epoch([&](const EpochStats<float>&) {
+        const uint64_t step = nn.training_state().step;
+        const uint64_t updated = step < 8 ? 1 : min<uint64_t>(step / 8 * 8, 24);
+        size_t index = 0;
+        for (const auto& layer : nn.dlayers()) {
+            auto dense = dynamic_cast<const Dense<float>*>(layer.get());
+            if (!dense) continue;
+            const size_t n = dense->in_features() * dense->out_features();
+            const double expected = floor(schedule.sparsity_at(updated) * double(n)) / double(n);
+            if (fabs(sparsity_of(*dense) - expected) > 1e-12) {
+                cerr << "FALLO: paso " << step << ", dispersión " << sparsity_of(*dense) << " en vez de " << expected << endl;
+                ok = false;
+            }
+            vector<bool> zero(n);
+            for (size_t k = 0; k < n; ++k) zero[k] = dense->weights_data()[k] == 0.0f;
+            for (size_t k = 0; k < previous[index].size(); ++k)
+                if (previous[index][k] && !zero[k]) {
+                    cerr << "FALLO: un peso podado revivió en el paso " << step << endl;
+                    ok = false;
+                    break;
+                }
+            previous[index++] = zero;
+        }
+        return ok;
+    });
+    nn.train<BCELoss, Adam>(X, Y, 9, 16, 0.05f);
+    if (!ok || nn.training_state().step != 36) return 1;
+
+    cout << "Pruning OK (" << sparsity_of(*dynamic_cast<const Dense<float>*>(nn.dlayers().front().get())) << ")" << endl;
+    return 0;
+}
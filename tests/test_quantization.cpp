@@ -0,0 +1,52 @@
+#include <iostream>
+#include <random>
+#include <cmath>
+#include "utec/neural_network/nn_quantization.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// La red cuantizada a int8 debe seguir de cerca a predict en fp32.
+int main(int argc, char* argv[]) {
+    const string path = argc > 1 ? argv[1] : "modelo.nn";
+    NeuralNetwork<float> nn;
+    nn.load(path);
+
+    const size_t n = 512, inputs = 784;
+    Tensor<float, 2> X(n, inputs);
+    mt19937 gen(5);
+    uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (auto& v : X) v = dist(gen);
+
+    Tensor<float, 2> calibration(128, inputs);
+    copy_n(X.data.begin(), calibration.data.size(), calibration.data.begin());
+    auto quantized = QuantizedNetwork<float>::build(nn, calibration);
+
+    auto expected = nn.predict(X);
+    auto got = quantized.predict(X);
+
+    // Las entradas aleatorias saturan algunas sigmoides, así que se mide el
+    // acuerdo de argmax y el error medio en vez del error máximo.
+    const size_t classes = got.shape()[1];
+    size_t agree = 0;
+    double mean_diff = 0.0;
+    for (size_t r = 0; r < n; ++r) {
+        size_t a = 0, b = 0;
+        for (size_t j = 0; j < classes; ++j) {
+            if (expected(r, j) > expected(r, a)) a = j;
+            if (got(r, j) > got(r, b)) b = j;
+            mean_diff += fabs(got(r, j) - expected(r, j));
+        }
+        agree += a == b;
+    }
+    mean_diff /= got.data.size();
+    cout << "Acuerdo argmax: " << agree << "/" << n << ", diferencia media: " << mean_diff << endl;
+
+    if (agree < n * 9 / 10 || mean_diff > 0.02) {
+        cerr << "FALLO: la red cuantizada se aleja demasiado de fp32" << endl;
+        return 1;
+    }
+    cout << "OK" << endl;
+    return 0;
+}
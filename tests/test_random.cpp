@@ -0,0 +1,175 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+NeuralNetwork<float> make_network(double rate) {
+    const rng::Stream init(7);
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Dense<float>>(8, 32, rng::he_uniform(init.split(0)), [](auto& b) { b.fill(0.0f); }));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<Dropout<float>>(float(rate), rng::Stream(11)));
+    nn.add_layer(make_unique<Dense<float>>(32, 32, rng::he_uniform(init.split(1)), [](auto& b) { b.fill(0.0f); }));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<Dropout<float>>(float(rate), rng::Stream(11, 1)));
+    nn.add_layer(make_unique<Dense<float>>(32, 1, rng::xavier_uniform(init.split(2)), [](auto& b) { b.fill(0.0f); }));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+    return nn;
+}
+
+} // namespace
+
+// Philox contra los vectores de Random123, llenado en paralelo igual al
+// escalar, inicializadores, barajado y Dropout (también con checkpointing).
+int main() {
+    {
+        const uint32_t expected[3][4] = {
+            {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u},
+            {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu},
+            {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}};
+        const auto zero = philox::block(0, 0, 0);
+        const auto ones = philox::block(~0ull, ~0ull, ~0ull);
+        const auto pi = philox::block(0x85a308d3243f6a88ull, 0x0370734413198a2eull, 0x299f31d0a4093822ull);
+        const array<uint32_t, 4>* got[3] = {&zero, &ones, &pi};
+        for (int k = 0; k < 3; ++k)
+            for (int j = 0; j < 4; ++j)
+                if ((*got[k])[j] != expected[k][j]) {
+                    cerr << "FALLO: Philox no coincide con el vector conocido " << k << endl;
+                    return 1;
+                }
+    }
+
+    // Tramos desalineados y en varios hilos: mismos valores que bits(i).
+    const rng::Stream stream(2025, 3);
+    {
+        vector<uint32_t> words(1037);
+        philox::fill_words(words.data(), words.size(), 5, stream.id(), stream.seed());
+        for (size_t i = 0; i < words.size(); ++i)
+            if (words[i] != stream.bits(5 + i)) {
+                cerr << "FALLO: fill_words difiere de bits en " << i << endl;
+                return 1;
+            }
+        vector<float> one(200003), many(200003);
+        stream.fill_uniform(one.data(), one.size(), -1.0f, 1.0f, 3, 1);
+        stream.fill_uniform(many.data(), many.size(), -1.0f, 1.0f, 3, 4);
+        vector<double> normal_one(100001), normal_many(100001);
+        stream.fill_normal(normal_one.data(), normal_one.size(), 0.0, 1.0, 0, 1);
+        stream.fill_normal(normal_many.data(), normal_many.size(), 0.0, 1.0, 0, 4);
+        if (one != many || normal_one != normal_many) {
+            cerr << "FALLO: el resultado depende del número de hilos" << endl;
+            return 1;
+        }
+        const double mean = accumulate(normal_one.begin(), normal_one.end(), 0.0) / normal_one.size();
+        double var = 0.0;
+        for (double v : normal_one) var += (v - mean) * (v - mean);
+        var /= normal_one.size();
+        if (fabs(mean) > 0.02 || fabs(var - 1.0) > 0.02) {
+            cerr << "FALLO: normal con media " << mean << " y varianza " << var << endl;
+            return 1;
+        }
+    }
+
+    // He normal: desviación sqrt(2 / fan_in).
+    {
+        Tensor<float, 2> w(256, 512);
+        rng::he_normal(stream.split(1))(w);
+        double sq = 0.0;
+        for (float v : w) sq += double(v) * v;
+        const double stddev = sqrt(sq / w.size());
+        if (fabs(stddev - sqrt(2.0 / 256)) > 0.005) {
+            cerr << "FALLO: he_normal con desviación " << stddev << endl;
+            return 1;
+        }
+    }
+
+    // Barajado: permutación determinista que sí cambia con el flujo.
+    {
+        vector<int> identity(1000);
+        iota(identity.begin(), identity.end(), 0);
+        vector<int> a = identity, b = identity, c = identity;
+        rng::shuffle(a.begin(), a.end(), stream.split(4));
+        rng::shuffle(b.begin(), b.end(), stream.split(4));
+        rng::shuffle(c.begin(), c.end(), stream.split(5));
+        vector<int> sorted = a;
+        sort(sorted.begin(), sorted.end());
+        if (a != b || a == c || a == identity || sorted != identity) {
+            cerr << "FALLO: el barajado no es una permutación determinista" << endl;
+            return 1;
+        }
+    }
+
+    // Dropout: proporción, escala, infer identidad y máscara del backward.
+    {
+        Dropout<float> dropout(0.25f, rng::Stream(3));
+        Tensor<float, 2> x(100, 100);
+        x.fill(1.0f);
+        const auto y = dropout.forward(x);
+        size_t kept = 0;
+        for (float v : y.data) {
+            if (v != 0.0f && fabs(v - 1.0f / 0.75f) > 1e-6f) {
+                cerr << "FALLO: Dropout escala mal" << endl;
+                return 1;
+            }
+            kept += v != 0.0f;
+        }
+        const auto g = dropout.backward(x);
+        if (kept < 7300 || kept > 7700 || g.data != y.data || dropout.infer(x).data != x.data) {
+            cerr << "FALLO: Dropout conserva " << kept << " de 10000" << endl;
+            return 1;
+        }
+        if (dropout.forward(x).data == y.data) {
+            cerr << "FALLO: Dropout repite la máscara" << endl;
+            return 1;
+        }
+    }
+
+    // Con checkpointing el recálculo repite las máscaras: mismos pesos.
+    Tensor<float, 2> X(128, 8), Y(128, 1);
+    stream.split(6).fill_normal(X.data.data(), X.size(), 0.0f, 1.0f);
+    for (size_t i = 0; i < 128; ++i) Y(i, 0) = X(i, 0) + X(i, 1) > 0.0f ? 1.0f : 0.0f;
+    auto plain = make_network(0.3);
+    auto checkpointed = make_network(0.3);
+    checkpointed.enable_activation_checkpointing(2);
+    plain.train<BCELoss, SGD>(X, Y, 3, 32, 0.1f);
+    checkpointed.train<BCELoss, SGD>(X, Y, 3, 32, 0.1f);
+    for (size_t l = 0; l < plain.dlayers().size(); ++l) {
+        auto a = plain.dlayers()[l]->parameters(), b = checkpointed.dlayers()[l]->parameters();
+        for (size_t p = 0; p < a.size(); ++p)
+            if (a[p]->data != b[p]->data) {
+                cerr << "FALLO: Dropout con checkpointing cambia los pesos de la capa " << l << endl;
+                return 1;
+            }
+    }
+
+    const string path = "test_random.nn";
+    plain.save(path);
+    NeuralNetwork<float> loaded;
+    loaded.load(path);
+    remove(path.c_str());
+    auto* reloaded = dynamic_cast<Dropout<float>*>(loaded.dlayers()[2].get());
+    const auto before = plain.predict(X), after = loaded.predict(X);
+    for (size_t i = 0; i < 128; ++i) {
+        if (!reloaded || fabs(reloaded->rate() - 0.3f) > 1e-6f || fabs(after(i, 0) - before(i, 0)) > 1e-4f) {
+            cerr << "FALLO: Dropout no sobrevive a save/load" << endl;
+            return 1;
+        }
+    }
+    // Tras cargar sigue con la máscara que tocaba, no vuelve a la primera.
+    auto* original = dynamic_cast<Dropout<float>*>(plain.dlayers()[2].get());
+    Tensor<float, 2> ones(16, 32);
+    ones.fill(1.0f);
+    if (original->forward(ones).data != reloaded->forward(ones).data) {
+        cerr << "FALLO: Dropout recargado repite máscaras ya usadas" << endl;
+        return 1;
+    }
+
+    cout << "Random OK" << endl;
+    return 0;
+}
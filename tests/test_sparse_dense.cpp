@@ -0,0 +1,59 @@
+#include <iostream>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// SparseDense debe calcular lo mismo que el Dense podado del que sale, y
+// sobrevivir a save/load.
+int main() {
+    mt19937 gen(4);
+    uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+
+    Dense<float> dense(20, 8, init, init);
+    prune_by_magnitude(dense, 0.75);
+    SparseDense<float> sparse(dense);
+    if (sparse.nnz() != 40 || fabs(sparse.sparsity() - 0.75) > 1e-9) {
+        cerr << "FALLO: dispersión inesperada " << sparse.sparsity() << endl;
+        return 1;
+    }
+
+    Tensor<float, 2> X(5, 20), dZ(5, 8);
+    init(X);
+    init(dZ);
+    for (size_t i = 0; i < 20; i += 3) X(1, i) = 0.0f;
+
+    auto max_diff = [](const Tensor<float, 2>& a, const Tensor<float, 2>& b) {
+        float d = 0.0f;
+        for (size_t i = 0; i < a.data.size(); ++i) d = max(d, fabs(a.data[i] - b.data[i]));
+        return d;
+    };
+    const float forward_diff = max_diff(dense.forward(X), sparse.forward(X));
+    const float backward_diff = max_diff(dense.backward(dZ), sparse.backward(dZ));
+
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Dense<float>>(dense));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.sparsify(0.5);
+    auto expected = nn.predict(X);
+    const string path = "test_sparse_dense.nn";
+    nn.save(path);
+    NeuralNetwork<float> loaded;
+    loaded.load(path);
+    remove(path.c_str());
+    const float load_diff = max_diff(expected, loaded.predict(X));
+
+    cout << "forward: " << forward_diff << ", backward: " << backward_diff << ", save/load: " << load_diff << endl;
+    if (forward_diff > 1e-5f || backward_diff > 1e-5f || load_diff > 1e-4f
+        || !dynamic_cast<SparseDense<float>*>(loaded.dlayers().front().get())) {
+        cerr << "FALLO: SparseDense no coincide con Dense" << endl;
+        return 1;
+    }
+    cout << "OK" << endl;
+    return 0;
+}
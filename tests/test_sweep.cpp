@@ -0,0 +1,98 @@
+#include <iostream>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <cmath>
+#include "utec/neural_network/neural_network.h"
+#include "utec/neural_network/nn_sweep.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+// Pool con robo de trabajo (cada tarea una vez, con costos desparejos) y
+// successive halving: cuántas configuraciones llegan a cada ronda, épocas,
+// orden de la tabla y mismo resultado con 1 o 4 hilos.
+int main() {
+    {
+        vector<atomic<int>> runs(50);
+        vector<function<void()>> tasks;
+        for (size_t i = 0; i < runs.size(); ++i)
+            tasks.push_back([&, i] {
+                if (i % 7 == 0) this_thread::sleep_for(chrono::milliseconds(5));
+                ++runs[i];
+            });
+        run_work_stealing(tasks, 4);
+        for (size_t i = 0; i < runs.size(); ++i)
+            if (runs[i] != 1) {
+                cerr << "FALLO: la tarea " << i << " corrió " << runs[i] << " veces" << endl;
+                return 1;
+            }
+    }
+
+    Tensor<float, 2> X(512, 4), Y(512, 1), X_val(128, 4), Y_val(128, 1);
+    const rng::Stream data(49);
+    data.split(0).fill_normal(X.data.data(), X.size(), 0.0f, 1.0f);
+    data.split(1).fill_normal(X_val.data.data(), X_val.size(), 0.0f, 1.0f);
+    for (size_t i = 0; i < 512; ++i) Y(i, 0) = X(i, 0) - X(i, 2) > 0.0f ? 1.0f : 0.0f;
+    for (size_t i = 0; i < 128; ++i) Y_val(i, 0) = X_val(i, 0) - X_val(i, 2) > 0.0f ? 1.0f : 0.0f;
+
+    // Con tasa 0 la red no aprende: nunca debería pasar de la primera ronda.
+    const auto trials = sweep_grid<float>({0.0f, 0.05f, 0.2f}, {16, 64, 128}, {{8}});
+    SweepRunner<float> runner(X, Y, X_val, Y_val, sweep_mlp<float>(4, 1));
+    SweepOptions options;
+    options.rungs = 3;
+    options.min_epochs = 1;
+    options.eta = 3;
+    options.workers = 1;
+    const auto serial = runner.run<BCELoss, SGD>(trials, options);
+    options.workers = 4;
+    const auto results = runner.run<BCELoss, SGD>(trials, options);
+
+    size_t finished = 0, per_rung[3] = {0, 0, 0};
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        if (!r.error.empty()) {
+            cerr << "FALLO: la configuración " << r.id << " falló: " << r.error << endl;
+            return 1;
+        }
+        if (r.id != serial[i].id || r.validation_loss != serial[i].validation_loss || r.epochs != serial[i].epochs) {
+            cerr << "FALLO: el resultado depende del número de hilos" << endl;
+            return 1;
+        }
+        finished += r.finished;
+        ++per_rung[r.rung];
+        const size_t expected_epochs = r.rung == 0 ? 1 : r.rung == 1 ? 3 : 9;
+        if (r.epochs != expected_epochs || (r.learning_rate == 0.0f && r.rung != 0)) {
+            cerr << "FALLO: la configuración " << r.id << " llegó a la ronda " << r.rung << " con " << r.epochs
+                 << " épocas" << endl;
+            return 1;
+        }
+    }
+    if (finished != 1 || per_rung[0] != 6 || per_rung[1] != 2 || per_rung[2] != 1 || !results.front().finished) {
+        cerr << "FALLO: successive halving dejó " << per_rung[0] << "/" << per_rung[1] << "/" << per_rung[2] << endl;
+        return 1;
+    }
+    for (size_t i = 1; i < results.size(); ++i)
+        if (results[i].rung == results[i - 1].rung && results[i].validation_loss < results[i - 1].validation_loss) {
+            cerr << "FALLO: la tabla no está ordenada" << endl;
+            return 1;
+        }
+    if (!runner.best() || results.front().accuracy < 0.9 ||
+        fabs(BCELoss<float>(runner.best()->predict(X_val), Y_val).loss() - results.front().validation_loss) > 1e-6f) {
+        cerr << "FALLO: la mejor red no corresponde a la mejor configuración" << endl;
+        return 1;
+    }
+
+    ostringstream table;
+    write_sweep_table(table, results, true);
+    size_t lines = 0;
+    for (char c : table.str()) lines += c == '\n';
+    if (lines != results.size() + 1 || table.str().rfind("id,tasa,", 0) != 0) {
+        cerr << "FALLO: tabla inesperada\n" << table.str();
+        return 1;
+    }
+
+    cout << "Sweep OK (mejor: " << results.front().id << ", exactitud " << results.front().accuracy << ")" << endl;
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <random>
+#include <utility>
+#include "utec/neural_network/neural_network.h"
+
+using namespace utec::algebra;
+using namespace utec::neural_network;
+using namespace std;
+
+namespace {
+
+// Presupuesto de reservas de Tensor por paso de train para la red de abajo
+// (4 capas). Si un cambio lo supera, hay copias nuevas en el camino caliente.
+constexpr uint64_t STEP_ALLOCATION_BUDGET = 19;
+
+bool check(bool ok, const char* what) {
+    if (!ok) cerr << "FALLO: " << what << endl;
+    return ok;
+}
+
+} // namespace
+
+// Compilado con UTEC_TENSOR_TELEMETRY: contadores de copias y movimientos,
+// memoria viva sin fugas y presupuesto de reservas por paso de entrenamiento.
+int main() {
+    bool ok = true;
+    const auto base = telemetry::totals();
+    {
+        Tensor<float, 2> a(4, 4);
+        Tensor<float, 2> b = a;
+        Tensor<float, 2> c = std::move(a);
+        b = c;
+        c = std::move(b);
+        const auto t = telemetry::totals();
+        ok &= check(t.allocations - base.allocations == 2, "reservas de copia/movimiento");
+        ok &= check(t.copies - base.copies == 2 && t.moves - base.moves == 2, "copias y movimientos");
+        ok &= check(t.live_tensors - base.live_tensors == 1, "tensores vivos");
+        ok &= check(t.live_bytes - base.live_bytes == 64, "bytes vivos");
+    }
+    ok &= check(telemetry::totals().live_bytes == base.live_bytes, "memoria liberada al salir del ámbito");
+
+    mt19937 gen(6);
+    uniform_real_distribution<float> dist(-0.1f, 0.1f);
+    auto init = [&](Tensor<float, 2>& t) { for (auto& v : t) v = dist(gen); };
+
+    NeuralNetwork<float> nn;
+    nn.add_layer(make_unique<Dense<float>>(32, 16, init, init));
+    nn.add_layer(make_unique<ReLU<float>>());
+    nn.add_layer(make_unique<Dense<float>>(16, 4, init, init));
+    nn.add_layer(make_unique<Sigmoid<float>>());
+
+    Tensor<float, 2> X(64, 32), Y(64, 4);
+    init(X);
+    for (size_t i = 0; i < 64; ++i) Y(i, i % 4) = 1.0f;
+
+    // Un paso para que Adam reserve sus momentos fuera de la medición.
+    nn.train<BCELoss, Adam>(X, Y, 1, 8, 0.01f);
+    nn.reset_tensor_stats();
+    const auto before = telemetry::totals();
+    const size_t steps = 8;
+    nn.train<BCELoss, Adam>(X, Y, 1, 8, 0.01f);
+    const auto after = telemetry::totals();
+
+    telemetry::Stats total;
+    for (const auto& [site, stats] : nn.tensor_stats()) {
+        cout << site << ": " << stats.allocations << " reservas, " << stats.bytes << " bytes, "
+             << stats.copies << " copias, " << stats.moves << " movimientos\n";
+        total += stats;
+    }
+    const uint64_t per_step = total.allocations / steps;
+    cout << "Por paso: " << per_step << " reservas (presupuesto " << STEP_ALLOCATION_BUDGET << ")\n";
+
+    ok &= check(total.allocations == after.allocations - before.allocations, "todas las reservas atribuidas");
+    ok &= check(nn.tensor_stats().count("0:Dense 32x16 forward") == 1, "sitio por capa");
+    ok &= check(nn.tensor_stats().at("0:Dense 32x16 forward").allocations > 0, "reservas en forward");
+    ok &= check(per_step <= STEP_ALLOCATION_BUDGET, "presupuesto de reservas por paso");
+    ok &= check(after.live_bytes == before.live_bytes, "sin memoria retenida entre pasos");
+    ok &= check(after.peak_bytes >= before.live_bytes, "pico de memoria");
+
+    if (!ok) return 1;
+    cout << "OK" << endl;
+    return 0;
+}